@@ -18,6 +18,27 @@ public class ImGui : ModuleRules
 		bool bBuildEditor = (Target.Type == TargetRules.TargetType.Editor);
 #endif
 
+		// Whether ImGui should use 32-bit draw indices (ImDrawIdx), allowing draw lists with more than 64K vertices.
+		// This changes ImGui data structures, so it is exported to all modules that use ImGui.
+		bool bUse32BitDrawIndices = false;
+
+		// Whether the current ImGui context should be thread-local instead of process-wide. This allows different threads to
+		// use different contexts at the same time (see FImGuiContextScope and ImGui.ParallelTick), at the cost of a function
+		// call for every access to the current context. This is required by ImGui.ParallelTick and ImGui.PipelinedRender.
+		// This changes how ImGui is accessed, so it is exported to all modules that use ImGui.
+		bool bThreadLocalContext = false;
+
+		string DrawIndicesDefinition = "IMGUI_USE_32BIT_DRAW_INDICES=" + (bUse32BitDrawIndices ? "1" : "0");
+		string ThreadLocalContextDefinition = "IMGUI_THREAD_LOCAL_CONTEXT=" + (bThreadLocalContext ? "1" : "0");
+#if UE_4_19_OR_LATER
+		PublicDefinitions.Add(DrawIndicesDefinition);
+		PublicDefinitions.Add(ThreadLocalContextDefinition);
+#else
+		Definitions.Add(DrawIndicesDefinition);
+		Definitions.Add(ThreadLocalContextDefinition);
+#endif
+
+
 		PublicIncludePaths.AddRange(
 			new string[] {
                 Path.Combine(ModuleDirectory, "Public"),
@@ -51,6 +72,7 @@ public class ImGui : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"ImGuiShaders",
 				"InputCore",
 				"Slate",
 				"SlateCore",
@@ -60,6 +82,23 @@ public class ImGui : ModuleRules
 			);
 
 
+		// Direct renderer is only compiled in engines that support it (see ImGuiShaders.Build.cs).
+		if (ImGuiShaders.IsDirectRendererEnabled())
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"RenderCore",
+					"RHI"
+				}
+				);
+
+#if !UE_4_22_OR_LATER
+			PrivateDependencyModuleNames.Add("ShaderCore");
+#endif
+		}
+
+
 		if (bBuildEditor)
 		{
 			PrivateDependencyModuleNames.AddRange(
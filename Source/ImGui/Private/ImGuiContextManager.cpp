@@ -4,14 +4,25 @@
 
 #include "ImGuiContextManager.h"
 
+#include "ImGuiContextScope.h"
 #include "ImGuiImplementation.h"
+#include "ImGuiStats.h"
 #include "Utilities/ScopeGuards.h"
 #include "Utilities/WorldContext.h"
 #include "Utilities/WorldContextIndex.h"
 
+#include <Async/ParallelFor.h>
+#include <Misc/CoreDelegates.h>
+
 #include <imgui.h>
 
 
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiContextManager, Warning, All);
+
+DECLARE_CYCLE_STAT(TEXT("Context Tick"), STAT_ImGui_ContextTick, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Parallel Ticked Contexts"), STAT_ImGui_ParallelTickedContexts, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ImGui Allocations"), STAT_ImGui_Allocations, STATGROUP_ImGui);
+
 namespace CVars
 {
 	TAutoConsoleVariable<int> DebugDrawOnWorldTick(TEXT("ImGui.DebugDrawOnWorldTick"), 1,
@@ -24,6 +35,17 @@ namespace CVars
 		TEXT("0: disabled, ImGui Debug Draw is called during Post-Tick\n")
 		TEXT("1: enabled (default), ImGui Debug Draw is called during World Tick Start"),
 		ECVF_Default);
+
+	TAutoConsoleVariable<int> ParallelTick(TEXT("ImGui.ParallelTick"), 0,
+		TEXT("Whether contexts should be ticked in parallel using task graph workers. Draw events that are not\n")
+		TEXT("thread-safe are still called on the game thread, before the parallel part. Thread-safe draw events\n")
+		TEXT("(see FImGuiModule::AddThreadSafeMultiContextImGuiDelegate), ending frames, capturing draw data and beginning\n")
+		TEXT("new frames are done on workers. Gains depend on the work done by thread-safe draw events, so compare\n")
+		TEXT("'Context Tick' in 'stat ImGui' with this disabled and enabled. Scaling with 1 to 8 contexts can be measured\n")
+		TEXT("with the ImGui.ContextManager.ParallelTickPerf automation test.\n")
+		TEXT("0: disabled, contexts are ticked one after another on the game thread (default)\n")
+		TEXT("1: enabled, if there is more than one context and ImGui is built with thread-local contexts"),
+		ECVF_Default);
 }
 
 namespace
@@ -79,23 +101,106 @@ FImGuiContextManager::FImGuiContextManager()
 	unsigned char* Pixels;
 	int Width, Height, Bpp;
 	FontAtlas.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+
+	// Frames rendered on workers need to be completed before anything in the next engine frame can use ImGui.
+	FCoreDelegates::OnBeginFrame.AddRaw(this, &FImGuiContextManager::CompleteFrames);
 }
 
 FImGuiContextManager::~FImGuiContextManager()
 {
 	// Order matters because contexts can be created during World Tick Start events.
 	FWorldDelegates::OnWorldTickStart.RemoveAll(this);
+	FCoreDelegates::OnBeginFrame.RemoveAll(this);
 }
 
 void FImGuiContextManager::Tick(float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ImGui_ContextTick);
+
+	// Allocations made through ImGui since the last tick, including frames rendered on workers. In a steady state, with
+	// the same windows open, this should stay at zero (see FImGuiFrameSnapshot::Update).
+	const uint32 AllocationsNum = ImGuiImplementation::GetAllocationsNum();
+	INC_DWORD_STAT_BY(STAT_ImGui_Allocations, AllocationsNum - LastAllocationsNum);
+	LastAllocationsNum = AllocationsNum;
+
 	// In editor, worlds can get invalid. We could remove corresponding entries, but that would mean resetting ImGui
 	// context every time when PIE session is restarted. Instead we freeze contexts until their worlds are re-created.
 
+	// Parallel tick requires thread-local contexts (see bThreadLocalContext in ImGui.Build.cs).
+	const bool bParallelTick = CVars::ParallelTick.GetValueOnGameThread() > 0;
+	if (bParallelTick && !IMGUI_THREAD_LOCAL_CONTEXT)
+	{
+		static bool bIsWarningLogged = false;
+		if (!bIsWarningLogged)
+		{
+			bIsWarningLogged = true;
+			UE_LOG(LogImGuiContextManager, Warning, TEXT("ImGui.ParallelTick is ignored, because ImGui is built without thread-local contexts ")
+				TEXT("(see bThreadLocalContext in ImGui.Build.cs)."));
+		}
+	}
+
+	if (IMGUI_THREAD_LOCAL_CONTEXT && bParallelTick && Contexts.Num() > 1)
+	{
+		// Game thread parts are called in the same order as in serial ticks.
+		TArray<FImGuiContextProxy*, TInlineAllocator<8>> TickedContexts;
+		for (auto& Pair : Contexts)
+		{
+			if (Pair.Value.PreTick(DeltaSeconds))
+			{
+				TickedContexts.Add(&Pair.Value);
+			}
+		}
+
+		// Current context is thread-local, so contexts can be ticked independently. Game thread can also pick up work,
+		// so its current context is restored.
+		ParallelFor(TickedContexts.Num(), [&](int32 Index)
+		{
+			const FImGuiContextScope ContextScope{ ImGui::GetCurrentContext() };
+			TickedContexts[Index]->TickConcurrent();
+		});
+
+		INC_DWORD_STAT_BY(STAT_ImGui_ParallelTickedContexts, TickedContexts.Num());
+
+		for (FImGuiContextProxy* ContextProxy : TickedContexts)
+		{
+			ContextProxy->PostTick();
+		}
+	}
+	else
+	{
+		for (auto& Pair : Contexts)
+		{
+			auto& ContextProxy = Pair.Value;
+			ContextProxy.Tick(DeltaSeconds);
+		}
+	}
+
+	// Contexts decided during their ticks whether the next engine frame ends with an update, so the current context
+	// needs to be set again to route direct draw calls to the right context (see FImGuiContextProxy::SetAsCurrent).
+	// Contexts with frames still rendered on workers are cleared instead, so the game thread cannot modify them before
+	// they are completed at the beginning of the next engine frame or in SetAsCurrent.
+	for (auto& Pair : Contexts)
+	{
+		if (Pair.Value.IsCurrentContext())
+		{
+			if (Pair.Value.IsFramePending())
+			{
+				ImGui::SetCurrentContext(nullptr);
+			}
+			else
+			{
+				Pair.Value.SetAsCurrent();
+			}
+			break;
+		}
+	}
+}
+
+void FImGuiContextManager::CompleteFrames()
+{
 	for (auto& Pair : Contexts)
 	{
-		auto& ContextProxy = Pair.Value;
-		ContextProxy.Tick(DeltaSeconds);
+		Pair.Value.CompleteFrame();
 	}
 }
 
@@ -106,7 +211,9 @@ FImGuiContextProxy* FImGuiContextManager::GetEditorContextProxy()
 
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace("", FImGuiContextProxy("", &DrawMultiContextEvent, &FontAtlas));
+		// Adding to the map can relocate proxies, so their render tasks need to be finished.
+		CompleteFrames();
+		Data = &Contexts.Emplace("", FImGuiContextProxy("", &DrawMultiContextEvent, &ThreadSafeDrawMultiContextEvent, &FontAtlas));
 	}
 
 	return Data;
@@ -128,7 +235,9 @@ FImGuiContextProxy* FImGuiContextManager::GetWorldContextProxy(const UWorld* Wor
 
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace(Key, FImGuiContextProxy(Key.ToString(), &DrawMultiContextEvent, &FontAtlas));
+		// Adding to the map can relocate proxies, so their render tasks need to be finished.
+		CompleteFrames();
+		Data = &Contexts.Emplace(Key, FImGuiContextProxy(Key.ToString(), &DrawMultiContextEvent, &ThreadSafeDrawMultiContextEvent, &FontAtlas));
 	}
 
 	return Data;
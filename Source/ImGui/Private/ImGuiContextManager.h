@@ -43,8 +43,16 @@ public:
 	// draw the same content to multiple contexts.
 	FSimpleMulticastDelegate& OnDrawMultiContext() { return DrawMultiContextEvent; }
 
+	// Thread-safe version of the multi-context draw event, called after OnDrawMultiContext. When contexts are ticked in
+	// parallel (see ImGui.ParallelTick), it can be called on worker threads, but broadcasts for different contexts are
+	// serialised (see FImGuiContextProxy::BroadcastDrawEvents).
+	FSimpleMulticastDelegate& OnThreadSafeDrawMultiContext() { return ThreadSafeDrawMultiContextEvent; }
+
 	void Tick(float DeltaSeconds);
 
+	// Complete frames that are still rendered on workers (see FImGuiContextProxy::CompleteFrame).
+	void CompleteFrames();
+
 private:
 
 	TMap<FName, FImGuiContextProxy> Contexts;
@@ -52,6 +60,10 @@ private:
 	FImGuiDemo ImGuiDemo;
 
 	FSimpleMulticastDelegate DrawMultiContextEvent;
+	FSimpleMulticastDelegate ThreadSafeDrawMultiContextEvent;
 
 	ImFontAtlas FontAtlas;
+
+	// Number of ImGui allocations at the last tick (see ImGuiImplementation::GetAllocationsNum).
+	uint32 LastAllocationsNum = 0;
 };
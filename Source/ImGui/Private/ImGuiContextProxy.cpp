@@ -4,9 +4,13 @@
 
 #include "ImGuiContextProxy.h"
 
+#include "ImGuiContextScope.h"
 #include "ImGuiImplementation.h"
 #include "ImGuiInteroperability.h"
+#include "ImGuiSettings.h"
+#include "ImGuiStats.h"
 
+#include <Hash/CityHash.h>
 #include <Runtime/Launch/Resources/Version.h>
 
 
@@ -16,13 +20,56 @@ static constexpr float DEFAULT_CANVAS_HEIGHT = 2160.f;
 static constexpr float DEFAULT_CANVAS_WIDTH_SCALE = 1.f;
 static constexpr float DEFAULT_CANVAS_HEIGHT_SCALE = 1.f;
 
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiContextProxy, Warning, All);
+
+DECLARE_CYCLE_STAT(TEXT("Render Task"), STAT_ImGui_RenderTask, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Render Task Wait"), STAT_ImGui_RenderTaskWait, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frame Snapshot Allocations"), STAT_ImGui_FrameSnapshotAllocations, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skipped Frames"), STAT_ImGui_SkippedFrames, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Wake-Ups"), STAT_ImGui_InputWakeUps, STATGROUP_ImGui);
+
 namespace CVars
 {
 	extern TAutoConsoleVariable<int> DebugDrawOnWorldTick;
+
+	TAutoConsoleVariable<int> OcclusionCulling(TEXT("ImGui.Render.OcclusionCulling"), 1,
+		TEXT("Whether draw lists of windows completely hidden behind opaque windows should be skipped before conversion.\n")
+		TEXT("Window is opaque, if its background color has no transparency (see also ImGui.Debug.OcclusionCulling).\n")
+		TEXT("0: disabled\n")
+		TEXT("1: enabled (default)"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> PipelinedRender(TEXT("ImGui.PipelinedRender"), 0,
+		TEXT("Whether ending ImGui frames (ImGui::Render) and capturing their draw data should be done on task graph workers,\n")
+		TEXT("overlapping with the rest of the engine frame. New ImGui frames are then started at the beginning of the next\n")
+		TEXT("engine frame or when context is set as current, waiting for the render task only if it is not finished yet.\n")
+		TEXT("0: disabled, frames are ended and started during the context tick (default)\n")
+		TEXT("1: enabled, if ImGui is built with thread-local contexts"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> UpdateRate(TEXT("ImGui.UpdateRate"), -1.f,
+		TEXT("Maximal number of ImGui frames per second for contexts without their own update rate. Engine frames between\n")
+		TEXT("updates reuse the last draw data and their time is passed to the next ImGui frame. Throttling is meant for\n")
+		TEXT("drawing from draw events. Code calling ImGui directly draws to a discard context in frames without update.\n")
+		TEXT("<0: use the value from ImGui settings (default)\n")
+		TEXT("0: no limit, contexts are updated in every engine frame\n")
+		TEXT(">0: maximal update rate in Hz"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> UpdateRateWakeOnInput(TEXT("ImGui.UpdateRate.WakeOnInput"), -1,
+		TEXT("Whether contexts with limited update rate should be updated in the next engine frame after their input changes.\n")
+		TEXT("-1: use the value from ImGui settings (default)\n")
+		TEXT("0: disabled, input is processed at the update rate\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
 }
 
 namespace
 {
+	// Shared thread-safe draw event is broadcast by all contexts, which can be ticked in parallel. Multicast delegates are
+	// not safe to broadcast from different threads at the same time, so those broadcasts are serialised.
+	FCriticalSection SharedThreadSafeDrawEventLock;
+
 	FString GetSaveDirectory()
 	{
 #if (ENGINE_MAJOR_VERSION > 4 || (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 18))
@@ -44,11 +91,38 @@ namespace
 		static FString SaveDirectory = GetSaveDirectory();
 		return FPaths::Combine(SaveDirectory, Name + TEXT(".ini"));
 	}
+
+	uint64 GetInputFingerprint(const FImGuiInputState& InputState)
+	{
+		struct FAnalogueState
+		{
+			float MouseX;
+			float MouseY;
+			float MouseWheelDelta;
+			uint32 CharactersNum;
+			uint32 Flags;
+		};
+
+		const FAnalogueState AnalogueState{ InputState.GetMousePosition().X, InputState.GetMousePosition().Y,
+			InputState.GetMouseWheelDelta(), static_cast<uint32>(InputState.GetCharactersNum()),
+			(InputState.IsControlDown() ? 1u : 0u) | (InputState.IsShiftDown() ? 2u : 0u) | (InputState.IsAltDown() ? 4u : 0u)
+			| (InputState.HasMousePointer() ? 8u : 0u) };
+
+		uint64 Hash = CityHash64(reinterpret_cast<const char*>(&AnalogueState), sizeof(AnalogueState));
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&InputState.GetKeys()), sizeof(FImGuiInputState::FKeysArray), Hash);
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&InputState.GetMouseButtons()), sizeof(FImGuiInputState::FMouseButtonsArray), Hash);
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&InputState.GetNavigationInputs()), sizeof(FImGuiInputState::FNavInputArray), Hash);
+		return Hash;
+	}
 }
 
-FImGuiContextProxy::FImGuiContextProxy(const FString& InName, FSimpleMulticastDelegate* InSharedDrawEvent, ImFontAtlas* InFontAtlas)
+FImGuiContextProxy::FImGuiContextProxy(const FString& InName, FSimpleMulticastDelegate* InSharedDrawEvent,
+	FSimpleMulticastDelegate* InSharedThreadSafeDrawEvent, ImFontAtlas* InFontAtlas)
 	: Name(InName)
+	, FontAtlas(InFontAtlas)
 	, SharedDrawEvent(InSharedDrawEvent)
+	, SharedThreadSafeDrawEvent(InSharedThreadSafeDrawEvent)
+	, DebugQueue(MakeShareable(new FImGuiDebugQueue()))
 	, IniFilename(TCHAR_TO_ANSI(*GetIniFile(InName)))
 {
 	// Create context.
@@ -81,13 +155,23 @@ FImGuiContextProxy::~FImGuiContextProxy()
 {
 	if (Context)
 	{
+		// Render task cannot outlive the context. Pending frame is dropped rather than completed, so no new frame is
+		// begun and no listeners are notified during teardown.
+		WaitForRenderTask();
+		bIsFramePending = false;
+
 		// Setting this as a current context is still required in the current framework version to properly shutdown
 		// and save data.
-		SetAsCurrent();
+		ImGui::SetCurrentContext(Context.Get());
 
 		// Save context data and destroy.
 		ImGui::DestroyContext(Context.Release());
 	}
+
+	if (DiscardContext)
+	{
+		ImGui::DestroyContext(DiscardContext.Release());
+	}
 }
 
 void FImGuiContextProxy::RequestInputState(TSharedRef<SWidget const> Asker)
@@ -130,72 +214,304 @@ FImGuiInputState * FImGuiContextProxy::TryGetInputState(SWidget const * Asker)
 
 void FImGuiContextProxy::SetDisplaySize(const FVector2D & Size)
 {
-	ImGuiContext * OldContext = ImGui::GetCurrentContext();
+	CompleteFrame();
 
-	SetAsCurrent();
+	const FImGuiContextScope ContextScope{ Context.Get() };
 
 	ImGuiIO& IO = ImGui::GetIO();
 
 	IO.DisplaySize = { Size.X, Size.Y };
 	DisplaySize = Size;
-
-	ImGui::SetCurrentContext(OldContext);
 }
 
 void FImGuiContextProxy::Draw()
 {
-	if (bIsFrameStarted && !bIsDrawCalled)
+	BroadcastDrawEvents(false);
+	BroadcastDrawEvents(true);
+}
+
+void FImGuiContextProxy::BroadcastDrawEvents(bool bThreadSafe)
+{
+	bool& bIsCalled = bThreadSafe ? bIsThreadSafeDrawCalled : bIsDrawCalled;
+	if (bIsFrameStarted && !bIsCalled)
 	{
-		bIsDrawCalled = true;
+		bIsCalled = true;
 
-		SetAsCurrent();
+		// Draw events always use this context, even if direct draw calls are discarded in the current engine frame.
+		CompleteFrame();
+		ImGui::SetCurrentContext(Context.Get());
 
-		const bool bSharedFirst = (CVars::DebugDrawOnWorldTick.GetValueOnGameThread() > 0);
+		FSimpleMulticastDelegate& ContextEvent = bThreadSafe ? ThreadSafeDrawEvent : DrawEvent;
+		FSimpleMulticastDelegate* SharedEvent = bThreadSafe ? SharedThreadSafeDrawEvent : SharedDrawEvent;
+
+		// Draw commands pushed from other threads since the last frame.
+		if (bThreadSafe)
+		{
+			DebugQueue->Draw();
+		}
+
+		const bool bSharedFirst = (CVars::DebugDrawOnWorldTick.GetValueOnAnyThread() > 0);
+
+		auto BroadcastSharedEvent = [SharedEvent, bThreadSafe]()
+		{
+			if (SharedEvent && bThreadSafe)
+			{
+				FScopeLock Lock(&SharedThreadSafeDrawEventLock);
+				if (SharedEvent->IsBound())
+				{
+					SharedEvent->Broadcast();
+				}
+			}
+			else if (SharedEvent && SharedEvent->IsBound())
+			{
+				SharedEvent->Broadcast();
+			}
+		};
 
 		// Broadcast draw event to allow listeners to draw their controls to this context.
-		if (bSharedFirst && SharedDrawEvent && SharedDrawEvent->IsBound())
+		if (bSharedFirst)
 		{
-			SharedDrawEvent->Broadcast();
+			BroadcastSharedEvent();
 		}
-		if (DrawEvent.IsBound())
+		if (ContextEvent.IsBound())
 		{
-			DrawEvent.Broadcast();
+			ContextEvent.Broadcast();
 		}
-		if (!bSharedFirst && SharedDrawEvent && SharedDrawEvent->IsBound())
+		if (!bSharedFirst)
 		{
-			SharedDrawEvent->Broadcast();
+			BroadcastSharedEvent();
 		}
 	}
 }
 
 void FImGuiContextProxy::Tick(float DeltaSeconds)
+{
+	if (PreTick(DeltaSeconds))
+	{
+		TickConcurrent();
+		PostTick();
+	}
+}
+
+bool FImGuiContextProxy::PreTick(float DeltaSeconds)
 {
 	// Making sure that we tick only once per frame.
 	if (LastFrameNumber < GFrameNumber)
 	{
 		LastFrameNumber = GFrameNumber;
 
-		SetAsCurrent();
+		// Time of skipped frames is passed to the next update.
+		AccumulatedDeltaSeconds += DeltaSeconds;
 
-		if (bIsFrameStarted)
+		// Whether this frame ends with an update was decided in the previous tick, so code drawing directly during this
+		// engine frame could get the right context (see SetAsCurrent).
+		const bool bUpdate = bIsUpdateScheduled;
+		bIsUpdateScheduled = ShouldUpdateNext(DeltaSeconds, bUpdate);
+
+		// Once created, discard context gets a new frame in every engine frame, so it never accumulates draw calls.
+		if (!bIsUpdateScheduled || DiscardContext)
 		{
-			// Make sure that draw events are called before the end of the frame.
-			Draw();
+			BeginDiscardFrame(DeltaSeconds);
+		}
+
+		if (!bUpdate)
+		{
+			INC_DWORD_STAT(STAT_ImGui_SkippedFrames);
+			return false;
+		}
 
-			// Ending frame will produce render output that we capture and store for later use. This also puts context to
-			// state in which it does not allow to draw controls, so we want to immediately start a new frame.
-			EndFrame();
+		CompleteFrame();
+
+		// Draw events that are not thread-safe need to be called on the game thread.
+		BroadcastDrawEvents(false);
+
+		return true;
+	}
+
+	return false;
+}
+
+void FImGuiContextProxy::TickConcurrent()
+{
+	const float DeltaSeconds = AccumulatedDeltaSeconds;
+	AccumulatedDeltaSeconds = 0.f;
+
+	ImGui::SetCurrentContext(Context.Get());
+
+	if (bIsFrameStarted)
+	{
+		// Make sure that draw events are called before the end of the frame.
+		Draw();
+
+		// Pipelined render requires thread-local contexts (see bThreadLocalContext in ImGui.Build.cs). Without them,
+		// contexts are ticked on the game thread.
+		const bool bPipelinedRender = CVars::PipelinedRender.GetValueOnAnyThread() > 0;
+		if (bPipelinedRender && !IMGUI_THREAD_LOCAL_CONTEXT)
+		{
+			static bool bIsWarningLogged = false;
+			if (!bIsWarningLogged)
+			{
+				bIsWarningLogged = true;
+				UE_LOG(LogImGuiContextProxy, Warning, TEXT("ImGui.PipelinedRender is ignored, because ImGui is built without thread-local contexts ")
+					TEXT("(see bThreadLocalContext in ImGui.Build.cs)."));
+			}
+		}
+
+		// Context cannot be used until the render task is finished, so the new frame is begun later (see CompleteFrame).
+		if (IMGUI_THREAD_LOCAL_CONTEXT && bPipelinedRender)
+		{
+			PendingDeltaSeconds = DeltaSeconds;
+			bIsFramePending = true;
+			bIsFrameStarted = false;
+
+			// The same as EndFrame, but frame state is updated before the task is dispatched.
+			RenderTask = FFunctionGraphTask::CreateAndDispatchWhenReady([this]()
+			{
+				SCOPE_CYCLE_COUNTER(STAT_ImGui_RenderTask);
+
+				const FImGuiContextScope ContextScope{ Context.Get() };
+				ImGui::Render();
+				UpdateDrawData(ImGui::GetDrawData());
+			}, TStatId{}, nullptr);
+
+			// Context cannot stay current on this thread while it is rendered. SetAsCurrent waits for the render task.
+			ImGui::SetCurrentContext(nullptr);
+
+			return;
+		}
+
+		// Ending frame will produce render output that we capture and store for later use. This also puts context to
+		// state in which it does not allow to draw controls, so we want to immediately start a new frame.
+		EndFrame();
+	}
+
+	UpdateFrameState();
+
+	// Begin a new frame and set the context back to a state in which it allows to draw controls.
+	BeginFrame(DeltaSeconds);
+}
+
+void FImGuiContextProxy::PostTick()
+{
+	// Pending frames are not rendered yet, so listeners are notified after they are completed.
+	if (bIsFramePending)
+	{
+		return;
+	}
+
+	// Only frames that look different need to be repainted.
+	if (bFrameChanged)
+	{
+		bFrameChanged = false;
+		FrameChangedEvent.Broadcast();
+	}
+}
+
+bool FImGuiContextProxy::ShouldUpdateNext(float DeltaSeconds, bool bIsUpdating)
+{
+	const UImGuiSettings* Settings = GetDefault<UImGuiSettings>();
+
+	float Rate = UpdateRate;
+	if (Rate < 0.f)
+	{
+		Rate = CVars::UpdateRate.GetValueOnGameThread();
+		if (Rate < 0.f)
+		{
+			Rate = Settings->GetUpdateRate();
 		}
+	}
+
+	// Input fingerprint is updated in every frame, so only new changes can wake up the context.
+	const uint64 LastInputFingerprint = InputFingerprint;
+	InputFingerprint = GetInputFingerprint(InputState);
 
-		// Update context information (some data, like mouse cursor, may be cleaned in new frame, so we should collect it
-		// beforehand).
-		bHasActiveItem = ImGui::IsAnyItemActive();
-		MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
-		DisplaySize = ImGuiInterops::ToVector2D(ImGui::GetIO().DisplaySize);
+	if (Rate <= 0.f)
+	{
+		return true;
+	}
 
-		// Begin a new frame and set the context back to a state in which it allows to draw controls.
-		BeginFrame(DeltaSeconds);
+	// Next frame is expected to take as long as the last one. Half of it is added on top, so updates are rounded to the
+	// nearest engine frame rather than delayed by a small jitter.
+	const float SecondsSinceUpdate = bIsUpdating ? 0.f : AccumulatedDeltaSeconds;
+	if (SecondsSinceUpdate + 1.5f * DeltaSeconds >= 1.f / Rate)
+	{
+		return true;
 	}
+
+	const int32 WakeOnInput = CVars::UpdateRateWakeOnInput.GetValueOnGameThread();
+	if ((WakeOnInput < 0 ? Settings->ShouldWakeOnInput() : WakeOnInput > 0) && InputFingerprint != LastInputFingerprint)
+	{
+		INC_DWORD_STAT(STAT_ImGui_InputWakeUps);
+		return true;
+	}
+
+	return false;
+}
+
+void FImGuiContextProxy::BeginDiscardFrame(float DeltaSeconds)
+{
+	const bool bIsNew = !DiscardContext.IsValid();
+	if (bIsNew)
+	{
+		// Created in a scope, so it does not become current, if there is no current context.
+		const FImGuiContextScope ContextScope{ ImGui::GetCurrentContext() };
+		DiscardContext = TUniquePtr<ImGuiContext>(ImGui::CreateContext(FontAtlas));
+	}
+
+	const FImGuiContextScope ContextScope{ DiscardContext.Get() };
+
+	ImGuiIO& IO = ImGui::GetIO();
+	if (bIsNew)
+	{
+		// Nothing from this context should be saved.
+		IO.IniFilename = nullptr;
+	}
+	else
+	{
+		// Frame is ended without rendering, which drops everything drawn in it.
+		ImGui::EndFrame();
+	}
+
+	IO.DisplaySize = { DisplaySize.X, DisplaySize.Y };
+	IO.DeltaTime = DeltaSeconds;
+	ImGui::NewFrame();
+}
+
+void FImGuiContextProxy::CompleteFrame()
+{
+	if (bIsFramePending)
+	{
+		WaitForRenderTask();
+		bIsFramePending = false;
+
+		const FImGuiContextScope ContextScope{ Context.Get() };
+		UpdateFrameState();
+		BeginFrame(PendingDeltaSeconds);
+
+		PostTick();
+	}
+}
+
+void FImGuiContextProxy::WaitForRenderTask()
+{
+	if (RenderTask.IsValid())
+	{
+		if (!RenderTask->IsComplete())
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ImGui_RenderTaskWait);
+			FTaskGraphInterface::Get().WaitUntilTaskCompletes(RenderTask);
+		}
+		RenderTask = nullptr;
+	}
+}
+
+void FImGuiContextProxy::UpdateFrameState()
+{
+	// Update context information (some data, like mouse cursor, may be cleaned in new frame, so we should collect it
+	// beforehand).
+	bHasActiveItem = ImGui::IsAnyItemActive();
+	MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
+	DisplaySize = ImGuiInterops::ToVector2D(ImGui::GetIO().DisplaySize);
 }
 
 void FImGuiContextProxy::BeginFrame(float DeltaTime)
@@ -211,6 +527,7 @@ void FImGuiContextProxy::BeginFrame(float DeltaTime)
 
 		bIsFrameStarted = true;
 		bIsDrawCalled = false;
+		bIsThreadSafeDrawCalled = false;
 	}
 }
 
@@ -231,18 +548,80 @@ void FImGuiContextProxy::EndFrame()
 
 void FImGuiContextProxy::UpdateDrawData(ImDrawData* DrawData)
 {
-	if (DrawData && DrawData->CmdListsCount > 0)
+	// Recycle the back snapshot, unless consumers still hold references to it (e.g. when it is used on other threads).
+	TRefCountPtr<FImGuiFrameSnapshot>& Snapshot = Frames.GetBack();
+	if (!Snapshot.IsValid() || !Snapshot->IsUnique())
 	{
-		DrawLists.SetNum(DrawData->CmdListsCount, false);
+		INC_DWORD_STAT(STAT_ImGui_FrameSnapshotAllocations);
+		Snapshot = new FImGuiFrameSnapshot();
+	}
 
-		for (int Index = 0; Index < DrawData->CmdListsCount; Index++)
-		{
-			DrawLists[Index].TransferDrawData(*DrawData->CmdLists[Index]);
-		}
+	// Opaque windows need to be found before draw lists are transferred.
+	OpaqueRects.Reset();
+	if (DrawData && CVars::OcclusionCulling.GetValueOnAnyThread() > 0)
+	{
+		ImGuiImplementation::GetOpaqueWindowRects(*DrawData, OpaqueRects);
 	}
-	else
+
+	Snapshot->Update(DrawData, ++RenderedFramesNum, OpaqueRects);
+
+	// Hash needs to be read before publishing, as after that the snapshot belongs to consumers.
+	const uint64 ContentHash = Snapshot->GetContentHash();
+
+	Frames.Publish();
+
+	// Listeners are notified on the game thread (see PostTick).
+	if (ContentHash != PublishedContentHash)
+	{
+		PublishedContentHash = ContentHash;
+		bFrameChanged = true;
+	}
+}
+
+FImGuiFrameSnapshotRef FImGuiContextProxy::GetFrame()
+{
+	Frames.Update();
+
+	const TRefCountPtr<FImGuiFrameSnapshot>& Snapshot = Frames.GetFront();
+	if (Snapshot.IsValid())
+	{
+		return FImGuiFrameSnapshotRef{ Snapshot.GetReference() };
+	}
+
+	// Nothing was published yet.
+	static const FImGuiFrameSnapshotRef EmptySnapshot = new FImGuiFrameSnapshot();
+	return EmptySnapshot;
+}
+
+#if WITH_OBSOLETE_CLIPPING_API
+const FImGuiDrawBatcher& FImGuiContextProxy::GetDrawBatches(const FImGuiFrameSnapshot& Frame, const FTransform2D& Transform, const FLinearColor& Tint,
+	const FSlateRotatedRect& VertexClippingRect)
+#else
+const FImGuiDrawBatcher& FImGuiContextProxy::GetDrawBatches(const FImGuiFrameSnapshot& Frame, const FTransform2D& Transform, const FLinearColor& Tint)
+#endif // WITH_OBSOLETE_CLIPPING_API
+{
+	// Convert every new frame snapshot and in every engine frame, as batch buffers are frame-scoped.
+	if (DrawBatcherFrameNumber != Frame.GetFrameNumber() || !DrawBatcher.HasValidBuffers())
 	{
-		// If we are not rendering then this might be a good moment to empty the array.
-		DrawLists.Empty();
+		DrawBatcherFrameNumber = Frame.GetFrameNumber();
+
+		// Batches are clipped to the canvas rather than to a widget, so they can be shared by widgets with different
+		// clipping rectangles.
+		const FSlateRect CanvasRect = TransformRect(Transform, FSlateRect{ FVector2D::ZeroVector, Frame.GetDisplaySize() });
+
+#if WITH_OBSOLETE_CLIPPING_API
+		DrawBatcher.Reset(Transform, Tint, CanvasRect, VertexClippingRect);
+#else
+		DrawBatcher.Reset(Transform, Tint, CanvasRect);
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+		for (const auto& DrawList : Frame.GetDrawLists())
+		{
+			DrawBatcher.AddDrawList(DrawList);
+		}
+
+		DrawBatcher.Convert();
 	}
+
+	return DrawBatcher;
 }
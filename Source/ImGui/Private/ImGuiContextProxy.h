@@ -2,9 +2,13 @@
 
 #pragma once
 
+#include "ImGuiDebugQueue.h"
 #include "ImGuiInputState.h"
-#include "ImGuiDrawData.h"
+#include "ImGuiDrawBatcher.h"
+#include "ImGuiFrameSnapshot.h"
+#include "Utilities/TripleBuffer.h"
 
+#include <Async/TaskGraphInterfaces.h>
 #include <ICursor.h>
 
 #include <imgui.h>
@@ -21,7 +25,8 @@ class FImGuiContextProxy
 {
 public:
 
-	FImGuiContextProxy(const FString& Name, FSimpleMulticastDelegate* InSharedDrawEvent, ImFontAtlas* InFontAtlas);
+	FImGuiContextProxy(const FString& Name, FSimpleMulticastDelegate* InSharedDrawEvent, FSimpleMulticastDelegate* InSharedThreadSafeDrawEvent,
+		ImFontAtlas* InFontAtlas);
 	~FImGuiContextProxy();
 
 	FImGuiContextProxy(const FImGuiContextProxy&) = delete;
@@ -33,8 +38,33 @@ public:
 	// Get the name of this context.
 	const FString& GetName() const { return Name; }
 
-	// Get draw data from the last frame.
-	const TArray<FImGuiDrawList>& GetDrawData() const { return DrawLists; }
+	// Get the latest complete frame. Frames are published through a lock-free triple buffer, so this never waits for
+	// the context update. This is the consumer side of that buffer and it should be used by one thread at a time (Slate),
+	// but returned snapshots are immutable and can be passed to and read from any thread.
+	// @returns Snapshot of the latest frame (empty, before the first frame is rendered)
+	FImGuiFrameSnapshotRef GetFrame();
+
+#if WITH_OBSOLETE_CLIPPING_API
+	// Get draw data converted to Slate batches. Conversion is done at most once per frame, using parameters from the
+	// first request, and shared by all widgets. Widgets with different parameters need to check whether they can use,
+	// translate or need to convert their own batches.
+	// @param Frame - Frame snapshot to convert (normally the one returned by GetFrame)
+	// @param Transform - Transform from ImGui canvas to screen space
+	// @param Tint - Tint to apply to vertex colors
+	// @param VertexClippingRect - Clipping rectangle for Slate vertices
+	// @returns Batches converted from the last draw data
+	const FImGuiDrawBatcher& GetDrawBatches(const FImGuiFrameSnapshot& Frame, const FTransform2D& Transform, const FLinearColor& Tint,
+		const FSlateRotatedRect& VertexClippingRect);
+#else
+	// Get draw data converted to Slate batches. Conversion is done at most once per frame, using parameters from the
+	// first request, and shared by all widgets. Widgets with different parameters need to check whether they can use,
+	// translate or need to convert their own batches.
+	// @param Frame - Frame snapshot to convert (normally the one returned by GetFrame)
+	// @param Transform - Transform from ImGui canvas to screen space
+	// @param Tint - Tint to apply to vertex colors
+	// @returns Batches converted from the last draw data
+	const FImGuiDrawBatcher& GetDrawBatches(const FImGuiFrameSnapshot& Frame, const FTransform2D& Transform, const FLinearColor& Tint);
+#endif // WITH_OBSOLETE_CLIPPING_API
 
 	// Get input state used by this context.
 	FImGuiInputState * GetInputState() const { return const_cast<FImGuiInputState *>(&InputState); }
@@ -46,11 +76,26 @@ public:
 	// Get input state used by this context.
 	FImGuiInputState* TryGetInputState(SWidget const * Asker);
 
-	// Is this context the current ImGui context.
-	bool IsCurrentContext() const { return ImGui::GetCurrentContext() == Context.Get(); }
-
-	// Set this context as current ImGui context.
-	void SetAsCurrent() { ImGui::SetCurrentContext(Context.Get()); }
+	// Is this context the current ImGui context (including the discard context used between updates).
+	bool IsCurrentContext() const
+	{
+		const ImGuiContext* CurrentContext = ImGui::GetCurrentContext();
+		return CurrentContext && (CurrentContext == Context.Get() || CurrentContext == DiscardContext.Get());
+	}
+
+	// Set this context as current ImGui context. If the last frame is still rendered on a worker (see
+	// ImGui.PipelinedRender), this waits for it and begins a new frame. If update rate is limited and the current engine
+	// frame does not end with an update, a discard context is set instead, so code drawing directly in every engine frame
+	// does not add the same controls to one ImGui frame many times.
+	void SetAsCurrent()
+	{
+		CompleteFrame();
+		ImGui::SetCurrentContext((bIsUpdateScheduled || !DiscardContext) ? Context.Get() : DiscardContext.Get());
+	}
+
+	// Whether the last frame is still rendered on a worker (see ImGui.PipelinedRender) and context cannot be used until it
+	// is completed.
+	bool IsFramePending() const { return bIsFramePending; }
 
 	// Context display size (read once per frame during context update and cached here for easy access).
 	const FVector2D& GetDisplaySize() const { return DisplaySize; }
@@ -66,13 +111,54 @@ public:
 	// Delegate called right before ending the frame to allows listeners draw their controls.
 	FSimpleMulticastDelegate& OnDraw() { return DrawEvent; }
 
+	// Delegate called after OnDraw, that can be called on worker threads when contexts are ticked in parallel (see
+	// ImGui.ParallelTick). Listeners must be safe to call from any thread while the game thread waits for the tick.
+	FSimpleMulticastDelegate& OnThreadSafeDraw() { return ThreadSafeDrawEvent; }
+
+	// Get queue of debug commands that can be pushed from any thread. Commands are drained together with thread-safe draw
+	// events.
+	const TSharedRef<FImGuiDebugQueue, ESPMode::ThreadSafe>& GetDebugQueue() const { return DebugQueue; }
+
+	// Delegate called after the context publishes a frame that looks different from the previous one (see
+	// FImGuiFrameSnapshot::GetContentHash). Widgets can use it to invalidate their cached paint.
+	FSimpleMulticastDelegate& OnFrameChanged() { return FrameChangedEvent; }
+
 	// Call draw events to allow listeners draw their widgets. Only one call per frame is processed. If it is not
 	// called manually before, then it will be called from the Tick function.
 	void Draw();
 
-	// Tick to advance context to the next frame. Only one call per frame will be processed.
+	// Get the maximal number of frames per second set for this context (0 for no limit or negative, if context uses
+	// the default from ImGui.UpdateRate and ImGui settings).
+	float GetUpdateRate() const { return UpdateRate; }
+
+	// Set the maximal number of frames per second for this context, overriding the default.
+	// @param Rate - Maximal update rate in Hz (0 for no limit or negative to use the default)
+	void SetUpdateRate(float Rate) { UpdateRate = Rate; }
+
+	// Tick to advance context to the next frame. Only one call per frame will be processed. If update rate is limited,
+	// frames can be skipped and their time is passed to the next update. Whether the next engine frame ends with an
+	// update is decided during this tick, so the right context can be set as current (see SetAsCurrent).
 	void Tick(float DeltaSeconds);
 
+	// Tick split into parts, so different contexts can be ticked in parallel. PreTick and PostTick must be called on the
+	// game thread. TickConcurrent can be called on any thread, concurrently with other contexts.
+
+	// Check whether context should advance in this frame and broadcast draw events that are not thread-safe.
+	// @param DeltaSeconds - Time since the last engine frame
+	// @returns True, if TickConcurrent and PostTick should be called in this frame
+	bool PreTick(float DeltaSeconds);
+
+	// Broadcast thread-safe draw events, end the frame, capture draw data and begin a new frame.
+	void TickConcurrent();
+
+	// Notify listeners about changes from the concurrent part of the tick.
+	void PostTick();
+
+	// If the last frame is rendered on a worker (see ImGui.PipelinedRender), wait until it is finished, if necessary, and
+	// begin a new frame. Should be called on the game thread before context is used in the next engine frame and before
+	// the proxy is moved.
+	void CompleteFrame();
+
 private:
 
 	void BeginFrame(float DeltaTime = 1.f / 60.f);
@@ -80,8 +166,24 @@ private:
 
 	void UpdateDrawData(ImDrawData* DrawData);
 
+	void UpdateFrameState();
+
+	// Decide whether the next engine frame should end with an update.
+	bool ShouldUpdateNext(float DeltaSeconds, bool bIsUpdating);
+
+	// Discard the frame of the discard context (created on the first call) and begin a new one.
+	void BeginDiscardFrame(float DeltaSeconds);
+
+	void WaitForRenderTask();
+
+	void BroadcastDrawEvents(bool bThreadSafe);
+
 	TUniquePtr<ImGuiContext> Context;
 
+	// Context receiving direct draw calls in engine frames that do not end with an update. Its frames are never rendered.
+	TUniquePtr<ImGuiContext> DiscardContext;
+	ImFontAtlas* FontAtlas = nullptr;
+
 	FVector2D DisplaySize = FVector2D::ZeroVector;
 
 	EMouseCursor::Type MouseCursor = EMouseCursor::None;
@@ -89,17 +191,50 @@ private:
 
 	bool bIsFrameStarted = false;
 	bool bIsDrawCalled = false;
+	bool bIsThreadSafeDrawCalled = false;
+
+	// Render task of the last frame and delta time for the frame that is started after it.
+	FGraphEventRef RenderTask;
+	float PendingDeltaSeconds = 0.f;
+	bool bIsFramePending = false;
 
 	uint32 LastFrameNumber = 0;
 
+	// Update rate override (negative to use the default), time accumulated since the last update, fingerprint of the
+	// input state used to wake up on input and whether the next tick should update.
+	float UpdateRate = -1.f;
+	float AccumulatedDeltaSeconds = 0.f;
+	uint64 InputFingerprint = 0;
+	bool bIsUpdateScheduled = true;
+
 	FSimpleMulticastDelegate DrawEvent;
 	FSimpleMulticastDelegate* SharedDrawEvent = nullptr;
 
+	FSimpleMulticastDelegate ThreadSafeDrawEvent;
+	FSimpleMulticastDelegate* SharedThreadSafeDrawEvent = nullptr;
+
+	// Shared with producers, so it stays valid when the proxy is moved or destroyed.
+	TSharedRef<FImGuiDebugQueue, ESPMode::ThreadSafe> DebugQueue;
+
+	FSimpleMulticastDelegate FrameChangedEvent;
+
 	FImGuiInputState InputState;
 
 	TArray<TWeakPtr<SWidget const>> InputRequests;
 
-	TArray<FImGuiDrawList> DrawLists;
+	// Frames published to consumers. Snapshots are recycled together with their draw lists, unless consumers still hold
+	// references to them.
+	Utilities::TTripleBuffer<TRefCountPtr<FImGuiFrameSnapshot>> Frames;
+	uint32 RenderedFramesNum = 0;
+	uint64 PublishedContentHash = 0;
+	bool bFrameChanged = false;
+
+	// Rectangles of opaque windows in the last rendered frame (kept to reuse allocation).
+	TArray<FSlateRect> OpaqueRects;
+
+	// Frame converted to batches shared by all widgets using this context.
+	FImGuiDrawBatcher DrawBatcher;
+	uint32 DrawBatcherFrameNumber = 0;
 
 	FString Name;
 	std::string IniFilename;
@@ -0,0 +1,288 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiDebugQueue.h"
+
+#include "ImGuiStats.h"
+#include "Utilities/BoundedMpscQueue.h"
+
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Debug Queue Commands"), STAT_ImGui_DebugQueueCommands, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Debug Queue Overflows"), STAT_ImGui_DebugQueueOverflows, STATGROUP_ImGui);
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> DebugQueueBudget(TEXT("ImGui.DebugQueue.Budget"), 256,
+		TEXT("Size in KB of memory reserved for debug commands pushed to a single ImGui context from any thread (default\n")
+		TEXT("256). Commands that do not fit are dropped. Changes only affect contexts created afterwards."),
+		ECVF_Default);
+}
+
+namespace
+{
+	constexpr const char* DefaultWindowName = "Debug Queue";
+	constexpr int32 PlotHistorySize = 128;
+}
+
+// Commands have a fixed size, so queue cells can be allocated up-front and pushing never allocates.
+struct FImGuiDebugQueue::FCommand
+{
+	enum class EType : uint8
+	{
+		Text,
+		Value,
+		PlotSample,
+		Line,
+		Rect,
+		Circle
+	};
+
+	EType Type = EType::Text;
+	ImU32 Color = 0;
+	float Data[5] = {};
+	char Window[32] = {};
+	char Label[32] = {};
+	char Text[96] = {};
+
+	FCommand() = default;
+
+	FCommand(EType InType, const char* InWindow, const char* InLabel = nullptr, const char* InText = nullptr)
+		: Type(InType)
+	{
+		FCStringAnsi::Strncpy(Window, InWindow ? InWindow : DefaultWindowName, sizeof(Window));
+		FCStringAnsi::Strncpy(Label, InLabel ? InLabel : "", sizeof(Label));
+		FCStringAnsi::Strncpy(Text, InText ? InText : "", sizeof(Text));
+	}
+};
+
+// Consumer state. Windows, values and plots are kept between frames, so they can be drawn in the same order.
+struct FImGuiDebugQueue::FImpl
+{
+	struct FPlot
+	{
+		char Name[32];
+		TArray<float> Samples;
+		int32 Offset = 0;
+
+		void Add(float Value)
+		{
+			if (Samples.Num() < PlotHistorySize)
+			{
+				Samples.Add(Value);
+			}
+			else
+			{
+				Samples[Offset] = Value;
+				Offset = (Offset + 1) % PlotHistorySize;
+			}
+		}
+	};
+
+	struct FWindow
+	{
+		char Name[32];
+		TArray<FCommand> Lines;
+		TArray<FCommand> Values;
+		TArray<FPlot> Plots;
+	};
+
+	explicit FImpl(int32 Capacity)
+		: Commands(Capacity)
+	{
+	}
+
+	FWindow& FindOrAddWindow(const char* Name)
+	{
+		if (FWindow* Window = Windows.FindByPredicate([Name](const FWindow& Candidate) { return FCStringAnsi::Strcmp(Candidate.Name, Name) == 0; }))
+		{
+			return *Window;
+		}
+
+		FWindow& Window = Windows[Windows.AddDefaulted()];
+		FCStringAnsi::Strncpy(Window.Name, Name, sizeof(Window.Name));
+		return Window;
+	}
+
+	Utilities::TBoundedMpscQueue<FCommand> Commands;
+	TArray<FWindow> Windows;
+	int32 LastNumOverflows = 0;
+};
+
+FImGuiDebugQueue::FImGuiDebugQueue()
+{
+	const SIZE_T Budget = static_cast<SIZE_T>(FMath::Max(CVars::DebugQueueBudget.GetValueOnGameThread(), 1)) * 1024;
+	Impl = MakeUnique<FImpl>(static_cast<int32>(Budget / sizeof(FCommand)));
+}
+
+FImGuiDebugQueue::~FImGuiDebugQueue() = default;
+
+int32 FImGuiDebugQueue::GetCapacity() const
+{
+	return Impl->Commands.GetCapacity();
+}
+
+bool FImGuiDebugQueue::Push(const FCommand& Command)
+{
+	if (!Impl->Commands.TryPush(Command))
+	{
+		FPlatformAtomics::InterlockedIncrement(&NumOverflows);
+		return false;
+	}
+
+	return true;
+}
+
+bool FImGuiDebugQueue::AddText(const char* Window, const char* Text, ImU32 Color)
+{
+	FCommand Command{ FCommand::EType::Text, Window, nullptr, Text };
+	Command.Color = Color;
+	return Push(Command);
+}
+
+bool FImGuiDebugQueue::AddValue(const char* Window, const char* Key, const char* Value)
+{
+	return Push({ FCommand::EType::Value, Window, Key, Value });
+}
+
+bool FImGuiDebugQueue::AddPlotSample(const char* Window, const char* Plot, float Value)
+{
+	FCommand Command{ FCommand::EType::PlotSample, Window, Plot };
+	Command.Data[0] = Value;
+	return Push(Command);
+}
+
+bool FImGuiDebugQueue::AddLine(const ImVec2& Start, const ImVec2& End, ImU32 Color, float Thickness)
+{
+	FCommand Command{ FCommand::EType::Line, nullptr };
+	Command.Color = Color;
+	Command.Data[0] = Start.x;
+	Command.Data[1] = Start.y;
+	Command.Data[2] = End.x;
+	Command.Data[3] = End.y;
+	Command.Data[4] = Thickness;
+	return Push(Command);
+}
+
+bool FImGuiDebugQueue::AddRect(const ImVec2& Min, const ImVec2& Max, ImU32 Color, float Thickness)
+{
+	FCommand Command{ FCommand::EType::Rect, nullptr };
+	Command.Color = Color;
+	Command.Data[0] = Min.x;
+	Command.Data[1] = Min.y;
+	Command.Data[2] = Max.x;
+	Command.Data[3] = Max.y;
+	Command.Data[4] = Thickness;
+	return Push(Command);
+}
+
+bool FImGuiDebugQueue::AddCircle(const ImVec2& Center, float Radius, ImU32 Color, float Thickness)
+{
+	FCommand Command{ FCommand::EType::Circle, nullptr };
+	Command.Color = Color;
+	Command.Data[0] = Center.x;
+	Command.Data[1] = Center.y;
+	Command.Data[2] = Radius;
+	Command.Data[4] = Thickness;
+	return Push(Command);
+}
+
+void FImGuiDebugQueue::Draw()
+{
+	FImpl& State = *Impl;
+
+	// Text lines are only shown in the frame in which they are received.
+	for (FImpl::FWindow& Window : State.Windows)
+	{
+		Window.Lines.Reset();
+	}
+
+	ImDrawList* OverlayDrawList = ImGui::GetOverlayDrawList();
+
+	int32 NumCommands = 0;
+	FCommand Command;
+	while (State.Commands.TryPop(Command))
+	{
+		NumCommands++;
+
+		switch (Command.Type)
+		{
+		case FCommand::EType::Text:
+			State.FindOrAddWindow(Command.Window).Lines.Add(Command);
+			break;
+
+		case FCommand::EType::Value:
+		{
+			TArray<FCommand>& Values = State.FindOrAddWindow(Command.Window).Values;
+			if (FCommand* Value = Values.FindByPredicate([&Command](const FCommand& Candidate) { return FCStringAnsi::Strcmp(Candidate.Label, Command.Label) == 0; }))
+			{
+				*Value = Command;
+			}
+			else
+			{
+				Values.Add(Command);
+			}
+			break;
+		}
+
+		case FCommand::EType::PlotSample:
+		{
+			TArray<FImpl::FPlot>& Plots = State.FindOrAddWindow(Command.Window).Plots;
+			FImpl::FPlot* Plot = Plots.FindByPredicate([&Command](const FImpl::FPlot& Candidate) { return FCStringAnsi::Strcmp(Candidate.Name, Command.Label) == 0; });
+			if (!Plot)
+			{
+				Plot = &Plots[Plots.AddDefaulted()];
+				FCStringAnsi::Strncpy(Plot->Name, Command.Label, sizeof(Plot->Name));
+			}
+			Plot->Add(Command.Data[0]);
+			break;
+		}
+
+		case FCommand::EType::Line:
+			OverlayDrawList->AddLine({ Command.Data[0], Command.Data[1] }, { Command.Data[2], Command.Data[3] }, Command.Color, Command.Data[4]);
+			break;
+
+		case FCommand::EType::Rect:
+			OverlayDrawList->AddRect({ Command.Data[0], Command.Data[1] }, { Command.Data[2], Command.Data[3] }, Command.Color, 0.f, ImDrawCornerFlags_All, Command.Data[4]);
+			break;
+
+		case FCommand::EType::Circle:
+			OverlayDrawList->AddCircle({ Command.Data[0], Command.Data[1] }, Command.Data[2], Command.Color, 24, Command.Data[4]);
+			break;
+		}
+	}
+
+	// Overflows are counted by producers, so stats are updated with a difference since the last drain.
+	const int32 Overflows = NumOverflows;
+	INC_DWORD_STAT_BY(STAT_ImGui_DebugQueueCommands, NumCommands);
+	INC_DWORD_STAT_BY(STAT_ImGui_DebugQueueOverflows, Overflows - State.LastNumOverflows);
+	State.LastNumOverflows = Overflows;
+
+	for (const FImpl::FWindow& Window : State.Windows)
+	{
+		if (ImGui::Begin(Window.Name))
+		{
+			if (Overflows > 0)
+			{
+				ImGui::TextColored({ 1.f, 0.5f, 0.f, 1.f }, "Dropped commands: %d (queue capacity %d)", Overflows, State.Commands.GetCapacity());
+				ImGui::Separator();
+			}
+
+			for (const FCommand& Line : Window.Lines)
+			{
+				ImGui::TextColored(ImColor{ Line.Color }, "%s", Line.Text);
+			}
+
+			for (const FCommand& Value : Window.Values)
+			{
+				ImGui::Text("%s: %s", Value.Label, Value.Text);
+			}
+
+			for (const FImpl::FPlot& Plot : Window.Plots)
+			{
+				ImGui::PlotLines(Plot.Name, Plot.Samples.GetData(), Plot.Samples.Num(), Plot.Offset, nullptr, FLT_MAX, FLT_MAX, { 0.f, 40.f });
+			}
+		}
+		ImGui::End();
+	}
+}
@@ -0,0 +1,557 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiDrawBatcher.h"
+
+#include "ImGuiDrawBufferPool.h"
+#include "ImGuiModuleManager.h"
+#include "ImGuiStats.h"
+
+#include <Async/ParallelFor.h>
+
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Draw Commands"), STAT_ImGui_DrawCommands, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Slate Elements"), STAT_ImGui_SlateElements, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CPU Clipped Commands"), STAT_ImGui_CPUClippedCommands, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Draw Commands"), STAT_ImGui_CulledDrawCommands, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Draw Lists"), STAT_ImGui_CulledDrawLists, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Occluded Draw Lists"), STAT_ImGui_OccludedDrawLists, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vertex Cache Hits"), STAT_ImGui_VertexCacheHits, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vertex Cache Misses"), STAT_ImGui_VertexCacheMisses, STATGROUP_ImGui);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Vertex Cache Entries"), STAT_ImGui_VertexCacheEntries, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Convert Draw Lists"), STAT_ImGui_ConvertDrawLists, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Copy Translated Batches"), STAT_ImGui_CopyTranslated, STATGROUP_ImGui);
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> SliceVertexData(TEXT("ImGui.Render.SliceVertexData"), 1,
+		TEXT("Whether each draw command should pass to Slate only vertices that it references.\n")
+		TEXT("0: disabled, each draw command gets a copy of all vertices from its draw list\n")
+		TEXT("1: enabled (default), each draw command gets only the range of vertices referenced by its indices"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> MergeDrawCommands(TEXT("ImGui.Render.MergeDrawCommands"), 1,
+		TEXT("Whether consecutive draw commands with the same texture and compatible clipping should be merged into\n")
+		TEXT("one Slate element.\n")
+		TEXT("0: disabled, every draw command is submitted as a separate element\n")
+		TEXT("1: enabled (default)"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> ClipQuadsOnCPU(TEXT("ImGui.Render.ClipQuadsOnCPU"), 0,
+		TEXT("Whether draw commands consisting only of axis-aligned quads (like text and frames) should be clipped on the CPU.\n")
+		TEXT("Such commands don't need their own clipping zones and can be merged with commands using different clipping\n")
+		TEXT("rectangles. Other geometry is still clipped by Slate.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> ParallelConversion(TEXT("ImGui.Render.ParallelConversion"), 0,
+		TEXT("Whether vertex and index data of different draw lists should be converted in parallel using task graph\n")
+		TEXT("workers.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled, if the number of vertices in a frame is not smaller than ImGui.Render.ParallelConversionMinVertices"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> ParallelConversionMinVertices(TEXT("ImGui.Render.ParallelConversionMinVertices"), 16384,
+		TEXT("Minimal number of vertices in a frame for which parallel conversion is used (see ImGui.Render.ParallelConversion).\n")
+		TEXT("Below this threshold overhead of scheduling tasks is higher than the gain, so conversion stays single-threaded."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> VertexCache(TEXT("ImGui.Render.VertexCache"), 1,
+		TEXT("Whether converted vertex data should be cached per window and reused in the next frames while the window's\n")
+		TEXT("vertices stay unchanged (as long as transform and tint don't change).\n")
+		TEXT("0: disabled, vertices are converted in every frame\n")
+		TEXT("1: enabled (default)"),
+		ECVF_Default);
+}
+
+namespace
+{
+	FORCEINLINE bool Contains(const FSlateRect& Outer, const FSlateRect& Inner)
+	{
+		return Outer.Left <= Inner.Left && Outer.Top <= Inner.Top && Outer.Right >= Inner.Right && Outer.Bottom >= Inner.Bottom;
+	}
+
+	FORCEINLINE bool IsEmpty(const FSlateRect& Rect)
+	{
+		return Rect.Left >= Rect.Right || Rect.Top >= Rect.Bottom;
+	}
+
+	FORCEINLINE bool Overlaps(const FSlateRect& A, const FSlateRect& B)
+	{
+		return A.Left < B.Right && B.Left < A.Right && A.Top < B.Bottom && B.Top < A.Bottom;
+	}
+
+	FORCEINLINE int32 Num(const Utilities::TRange<int32>& Range)
+	{
+		return Range.GetEnd() - Range.GetBegin();
+	}
+
+	FORCEINLINE FImGuiDrawBufferPool& GetDrawBufferPool()
+	{
+		return FImGuiModule::Get().GetImGuiModuleManager()->GetDrawBufferPool();
+	}
+
+	// Quads can be clipped on the CPU only if they stay axis-aligned after transform.
+	FORCEINLINE bool HasRotation(const FTransform2D& Transform)
+	{
+		float M00, M01, M10, M11;
+		Transform.GetMatrix().GetMatrix(M00, M01, M10, M11);
+		return M01 != 0.f || M10 != 0.f;
+	}
+}
+
+#if WITH_OBSOLETE_CLIPPING_API
+void FImGuiDrawBatcher::Reset(const FTransform2D& InTransform, const FLinearColor& Tint, const FSlateRect& InClippingRect, const FSlateRotatedRect& InVertexClippingRect)
+#else
+void FImGuiDrawBatcher::Reset(const FTransform2D& InTransform, const FLinearColor& Tint, const FSlateRect& InClippingRect)
+#endif // WITH_OBSOLETE_CLIPPING_API
+{
+	Transform = InTransform;
+	ClippingRect = InClippingRect;
+#if WITH_OBSOLETE_CLIPPING_API
+	VertexClippingRect = InVertexClippingRect;
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+	// Color table is only rebuilt when tint changes.
+	ColorTable.SetTint(Tint);
+
+	bSliceVertexData = (CVars::SliceVertexData.GetValueOnGameThread() > 0);
+	bMergeCommands = (CVars::MergeDrawCommands.GetValueOnGameThread() > 0);
+	bClipQuads = (CVars::ClipQuadsOnCPU.GetValueOnGameThread() > 0) && !HasRotation(Transform);
+	bUseVertexCache = (CVars::VertexCache.GetValueOnGameThread() > 0);
+
+	// Keep only cache entries used in the last frame.
+	FrameNb++;
+	for (auto It = VertexCache.CreateIterator(); It; ++It)
+	{
+		if (!bUseVertexCache || It.Value().LastUsedFrame + 1 < FrameNb)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	SET_DWORD_STAT(STAT_ImGui_VertexCacheEntries, VertexCache.Num());
+
+	BufferPool = &GetDrawBufferPool();
+	BufferPoolFrame = BufferPool->GetFrameNumber();
+
+	BatchesNum = 0;
+	CommandsNum = 0;
+	CulledCommandsNum = 0;
+	CulledListsNum = 0;
+	OccludedListsNum = 0;
+	CacheHitsNum = 0;
+	CacheMissesNum = 0;
+	VertexSegment = FVertexSegment{};
+
+	PendingCopies.Reset();
+	DrawListConversions.Reset();
+	PendingVerticesNum = 0;
+}
+
+void FImGuiDrawBatcher::AddDrawList(const FImGuiDrawList& DrawList)
+{
+	// Skip the whole list if none of its clipping rectangles is visible (e.g. windows moved off-screen).
+	if (!Overlaps(DrawList.GetClippingBounds(Transform), ClippingRect))
+	{
+		CulledListsNum++;
+		CulledCommandsNum += DrawList.NumCommands();
+		INC_DWORD_STAT(STAT_ImGui_CulledDrawLists);
+		INC_DWORD_STAT_BY(STAT_ImGui_CulledDrawCommands, DrawList.NumCommands());
+		INC_DWORD_STAT_BY(STAT_ImGui_DrawCommands, DrawList.NumCommands());
+		return;
+	}
+
+	// Skip the whole list if it is hidden behind opaque windows.
+	if (DrawList.IsOccluded())
+	{
+		OccludedListsNum++;
+		CulledCommandsNum += DrawList.NumCommands();
+		INC_DWORD_STAT(STAT_ImGui_OccludedDrawLists);
+		INC_DWORD_STAT_BY(STAT_ImGui_CulledDrawCommands, DrawList.NumCommands());
+		INC_DWORD_STAT_BY(STAT_ImGui_DrawCommands, DrawList.NumCommands());
+		return;
+	}
+
+	// If Slate indices cannot address all vertices in this list, then vertex data need to be sliced.
+	const bool bSliceDrawList = bSliceVertexData || (DrawList.NumVertices() > MaxSlateIndexedVertices);
+
+	// Copies for this list start here (see Convert).
+	FDrawListConversion& Conversion = DrawListConversions[DrawListConversions.AddUninitialized()];
+	Conversion.DrawList = &DrawList;
+	Conversion.FirstCopy = PendingCopies.Num();
+	// Lists without an owner fall back to their position in this frame.
+	Conversion.CacheKey = DrawList.GetOwnerId() ? DrawList.GetOwnerId() : DrawListConversions.Num() - 1;
+	Conversion.Cache = nullptr;
+	Conversion.bCached = bUseVertexCache;
+	Conversion.bFillCache = false;
+
+	if (bUseVertexCache)
+	{
+		FCachedVertexData& Cache = VertexCache.FindOrAdd(Conversion.CacheKey);
+
+		// Every entry belongs to a single list. If the key is already taken in this frame, this list is not cached.
+		if (Cache.LastUsedFrame == FrameNb)
+		{
+			Conversion.bCached = false;
+		}
+		else
+		{
+			Cache.LastUsedFrame = FrameNb;
+
+			if (!IsCacheValid(Cache, DrawList))
+			{
+				Cache.VertexDataHash = DrawList.GetVertexDataHash();
+				Cache.Transform = Transform;
+				Cache.Tint = ColorTable.GetTint();
+#if WITH_OBSOLETE_CLIPPING_API
+				Cache.VertexClippingRect = VertexClippingRect;
+#endif // WITH_OBSOLETE_CLIPPING_API
+				Cache.VertexBuffer.SetNumUninitialized(DrawList.NumVertices(), false);
+				Cache.bValid = true;
+
+				Conversion.bFillCache = true;
+			}
+		}
+
+		if (Conversion.bFillCache)
+		{
+			CacheMissesNum++;
+			INC_DWORD_STAT(STAT_ImGui_VertexCacheMisses);
+		}
+		else if (Conversion.bCached)
+		{
+			CacheHitsNum++;
+			INC_DWORD_STAT(STAT_ImGui_VertexCacheHits);
+		}
+	}
+
+	int32 IndexBufferOffset = 0;
+	for (int CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
+	{
+		const auto& DrawCommand = DrawList.GetCommand(CommandNb, Transform);
+
+		const int32 StartIndex = IndexBufferOffset;
+
+		// Advance offset by number of elements to position it for the next command.
+		IndexBufferOffset += DrawCommand.NumElements;
+
+		// Transform clipping rectangle to screen space and apply to elements that we draw.
+		const FSlateRect CommandClippingRect = DrawCommand.ClippingRect.IntersectionWith(ClippingRect);
+
+		// Nothing from this command would be visible.
+		if (IsEmpty(CommandClippingRect))
+		{
+			CulledCommandsNum++;
+			INC_DWORD_STAT(STAT_ImGui_CulledDrawCommands);
+			continue;
+		}
+
+		// Quads clipped on the CPU are never outside of the widget's clipping rectangle, so they can share it with
+		// batches from any other command.
+		const int32 NumQuadVertices = DrawCommand.NumElements / 6 * 4;
+		if (bClipQuads && NumQuadVertices <= MaxSlateIndexedVertices && DrawList.IsAxisAlignedQuads(StartIndex, DrawCommand.NumElements))
+		{
+			CommandsNum++;
+
+			FImGuiDrawBatch& Batch = CanMerge(DrawCommand, ClippingRect, NumQuadVertices)
+				? Batches[BatchesNum - 1]
+				: AddBatch(DrawCommand, ClippingRect);
+
+			AddClippedQuads(Batch, DrawList, StartIndex, DrawCommand.NumElements, CommandClippingRect);
+			continue;
+		}
+
+		// Either only vertices referenced by this command or all vertices from the list.
+		const Utilities::TRange<int32> VertexRange = bSliceDrawList
+			? DrawList.GetVertexRange(StartIndex, DrawCommand.NumElements)
+			: DrawList.GetVertexRange();
+
+		if (!ensureMsgf(Num(VertexRange) <= MaxSlateIndexedVertices,
+			TEXT("ImGui draw command references %d vertices, which is more than Slate indices can address (%d). Command is skipped."),
+			Num(VertexRange), MaxSlateIndexedVertices))
+		{
+			continue;
+		}
+
+		CommandsNum++;
+
+		// Geometry that is not affected by either of the clipping rectangles can be drawn with any of them. This is
+		// a common case for nested rectangles, like text inside of a window.
+		const bool bMerge = CanMerge(DrawCommand, CommandClippingRect, Num(VertexRange))
+			|| (CanMerge(DrawCommand, Num(VertexRange)) && Contains(CommandClippingRect.IntersectionWith(Batches[BatchesNum - 1].ClippingRect),
+				DrawList.GetVertexBounds(DrawList.GetVertexRange(StartIndex, DrawCommand.NumElements), Transform)));
+
+		FImGuiDrawBatch& Batch = bMerge
+			? Batches[BatchesNum - 1]
+			: AddBatch(DrawCommand, CommandClippingRect);
+
+		AddCommand(Batch, DrawList, StartIndex, DrawCommand.NumElements, VertexRange);
+	}
+
+	INC_DWORD_STAT_BY(STAT_ImGui_DrawCommands, DrawList.NumCommands());
+}
+
+bool FImGuiDrawBatcher::CanMerge(const FImGuiDrawCommand& DrawCommand, int32 NumVertices) const
+{
+	if (!bMergeCommands || BatchesNum == 0)
+	{
+		return false;
+	}
+
+	const FImGuiDrawBatch& Batch = Batches[BatchesNum - 1];
+
+	// Merged batch needs to be addressable by Slate indices (this is an upper bound as some vertices can be shared).
+	return Batch.TextureId == DrawCommand.TextureId && Batch.VertexBuffer->Num() + NumVertices <= MaxSlateIndexedVertices;
+}
+
+bool FImGuiDrawBatcher::CanMerge(const FImGuiDrawCommand& DrawCommand, const FSlateRect& CommandClippingRect, int32 NumVertices) const
+{
+	return CanMerge(DrawCommand, NumVertices) && Batches[BatchesNum - 1].ClippingRect == CommandClippingRect;
+}
+
+FImGuiDrawBatch& FImGuiDrawBatcher::AddBatch(const FImGuiDrawCommand& DrawCommand, const FSlateRect& BatchClippingRect)
+{
+	if (BatchesNum == Batches.Num())
+	{
+		Batches.AddDefaulted();
+	}
+
+	FImGuiDrawBatch& Batch = Batches[BatchesNum++];
+
+	Batch.ClippingRect = BatchClippingRect;
+	Batch.TextureId = DrawCommand.TextureId;
+	Batch.VertexBuffer = &BufferPool->AcquireVertexBuffer();
+	Batch.IndexBuffer = &BufferPool->AcquireIndexBuffer();
+	Batch.NumCommands = 0;
+
+	INC_DWORD_STAT(STAT_ImGui_SlateElements);
+
+	return Batch;
+}
+
+void FImGuiDrawBatcher::AddCommand(FImGuiDrawBatch& Batch, const FImGuiDrawList& DrawList, int32 StartIndex, int32 NumElements,
+	const Utilities::TRange<int32>& VertexRange)
+{
+	// Commands from the same list often reference overlapping or adjacent vertex ranges, so as long as we add to the same
+	// batch, we can extend the last copied segment instead of copying vertices again.
+	const bool bExtendSegment = (VertexSegment.DrawList == &DrawList) && (Batch.VertexBuffer->Num() > 0)
+		&& (&Batches[BatchesNum - 1] == &Batch)
+		&& (VertexRange.GetBegin() >= VertexSegment.SourceRange.GetBegin())
+		&& (VertexRange.GetBegin() <= VertexSegment.SourceRange.GetEnd());
+
+	if (!bExtendSegment)
+	{
+		VertexSegment.DrawList = &DrawList;
+		VertexSegment.SourceRange.SetRange(VertexRange.GetBegin(), VertexRange.GetBegin());
+		VertexSegment.BatchOffset = Batch.VertexBuffer->Num();
+	}
+
+	// Reserve space for vertex and index data. Data are copied in Convert, after all batches are known and buffers won't
+	// be reallocated.
+	FPendingCopy& Copy = PendingCopies[PendingCopies.AddUninitialized()];
+	Copy.DrawList = &DrawList;
+	Copy.BatchNb = BatchesNum - 1;
+
+	if (VertexRange.GetEnd() > VertexSegment.SourceRange.GetEnd())
+	{
+		Copy.VertexRange.SetRange(VertexSegment.SourceRange.GetEnd(), VertexRange.GetEnd());
+		Copy.VertexOffset = Batch.VertexBuffer->AddUninitialized(Num(Copy.VertexRange));
+		PendingVerticesNum += Num(Copy.VertexRange);
+
+		VertexSegment.SourceRange.SetRange(VertexSegment.SourceRange.GetBegin(), VertexRange.GetEnd());
+	}
+	else
+	{
+		Copy.VertexRange = {};
+		Copy.VertexOffset = 0;
+	}
+
+	// Indices are rebased from positions in the draw list to positions in the batch.
+	Copy.StartIndex = StartIndex;
+	Copy.NumElements = NumElements;
+	Copy.IndexOffset = Batch.IndexBuffer->AddUninitialized(NumElements);
+	Copy.IndexRebase = VertexSegment.SourceRange.GetBegin() - VertexSegment.BatchOffset;
+
+	Batch.NumCommands++;
+}
+
+void FImGuiDrawBatcher::AddClippedQuads(FImGuiDrawBatch& Batch, const FImGuiDrawList& DrawList, int32 StartIndex, int32 NumElements,
+	const FSlateRect& CommandClippingRect)
+{
+#if WITH_OBSOLETE_CLIPPING_API
+	DrawList.AppendClippedQuads(*Batch.VertexBuffer, *Batch.IndexBuffer, Transform, ColorTable, VertexClippingRect, StartIndex, NumElements,
+		CommandClippingRect);
+#else
+	DrawList.AppendClippedQuads(*Batch.VertexBuffer, *Batch.IndexBuffer, Transform, ColorTable, StartIndex, NumElements, CommandClippingRect);
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+	// Vertices appended after clipped quads cannot extend the previous segment.
+	VertexSegment = FVertexSegment{};
+
+	Batch.NumCommands++;
+
+	INC_DWORD_STAT(STAT_ImGui_CPUClippedCommands);
+}
+
+bool FImGuiDrawBatcher::IsCacheValid(const FCachedVertexData& Cache, const FImGuiDrawList& DrawList) const
+{
+	return Cache.bValid && Cache.VertexDataHash == DrawList.GetVertexDataHash()
+		&& Cache.VertexBuffer.Num() == DrawList.NumVertices() && Cache.Transform == Transform
+		&& Cache.Tint == ColorTable.GetTint()
+#if WITH_OBSOLETE_CLIPPING_API
+		&& FMemory::Memcmp(&Cache.VertexClippingRect, &VertexClippingRect, sizeof(FSlateRotatedRect)) == 0
+#endif // WITH_OBSOLETE_CLIPPING_API
+		;
+}
+
+void FImGuiDrawBatcher::Convert()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ImGui_ConvertDrawLists);
+
+	const int32 NumDrawLists = DrawListConversions.Num();
+
+	// Cache entries are only added in AddDrawList, so from now on their addresses are stable.
+	for (FDrawListConversion& Conversion : DrawListConversions)
+	{
+		Conversion.Cache = Conversion.bCached ? VertexCache.Find(Conversion.CacheKey) : nullptr;
+	}
+
+	auto ConvertDrawList = [this, NumDrawLists](int32 DrawListNb)
+	{
+		const FDrawListConversion& Conversion = DrawListConversions[DrawListNb];
+		const int32 EndCopy = (DrawListNb + 1 < NumDrawLists) ? DrawListConversions[DrawListNb + 1].FirstCopy : PendingCopies.Num();
+
+		// Cache entries belong to a single list, so they can be filled right before they are copied.
+		if (Conversion.bFillCache)
+		{
+#if WITH_OBSOLETE_CLIPPING_API
+			Conversion.DrawList->CopyVertexData(Conversion.Cache->VertexBuffer.GetData(), Transform, ColorTable, VertexClippingRect, Conversion.DrawList->GetVertexRange());
+#else
+			Conversion.DrawList->CopyVertexData(Conversion.Cache->VertexBuffer.GetData(), Transform, ColorTable, Conversion.DrawList->GetVertexRange());
+#endif // WITH_OBSOLETE_CLIPPING_API
+		}
+
+		for (int32 CopyNb = Conversion.FirstCopy; CopyNb < EndCopy; CopyNb++)
+		{
+			const FPendingCopy& Copy = PendingCopies[CopyNb];
+			FImGuiDrawBatch& Batch = Batches[Copy.BatchNb];
+
+			if (Num(Copy.VertexRange) > 0)
+			{
+				FSlateVertex* Dst = Batch.VertexBuffer->GetData() + Copy.VertexOffset;
+				if (Conversion.Cache)
+				{
+					FMemory::Memcpy(Dst, Conversion.Cache->VertexBuffer.GetData() + Copy.VertexRange.GetBegin(), Num(Copy.VertexRange) * sizeof(FSlateVertex));
+				}
+				else
+				{
+#if WITH_OBSOLETE_CLIPPING_API
+					Copy.DrawList->CopyVertexData(Dst, Transform, ColorTable, VertexClippingRect, Copy.VertexRange);
+#else
+					Copy.DrawList->CopyVertexData(Dst, Transform, ColorTable, Copy.VertexRange);
+#endif // WITH_OBSOLETE_CLIPPING_API
+				}
+			}
+
+			Copy.DrawList->CopyIndexData(Batch.IndexBuffer->GetData() + Copy.IndexOffset, Copy.StartIndex, Copy.NumElements, Copy.IndexRebase);
+		}
+	};
+
+	// Different draw lists write to disjoint parts of batch buffers, so they can be converted in parallel.
+	const bool bParallel = (CVars::ParallelConversion.GetValueOnGameThread() > 0)
+		&& (PendingVerticesNum >= CVars::ParallelConversionMinVertices.GetValueOnGameThread()) && (NumDrawLists > 1);
+
+	ParallelFor(NumDrawLists, ConvertDrawList, !bParallel);
+
+	PendingCopies.Reset();
+	DrawListConversions.Reset();
+	PendingVerticesNum = 0;
+}
+
+#if WITH_OBSOLETE_CLIPPING_API
+bool FImGuiDrawBatcher::IsConvertedWith(const FTransform2D& InTransform, const FLinearColor& Tint, const FSlateRotatedRect& InVertexClippingRect) const
+{
+	return Transform == InTransform && ColorTable.GetTint() == Tint
+		&& FMemory::Memcmp(&VertexClippingRect, &InVertexClippingRect, sizeof(FSlateRotatedRect)) == 0;
+}
+#else
+bool FImGuiDrawBatcher::IsConvertedWith(const FTransform2D& InTransform, const FLinearColor& Tint) const
+{
+	return Transform == InTransform && ColorTable.GetTint() == Tint;
+}
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+bool FImGuiDrawBatcher::HasValidBuffers() const
+{
+	return BufferPool && BufferPoolFrame == BufferPool->GetFrameNumber();
+}
+
+bool FImGuiDrawBatcher::GetTranslationTo(const FTransform2D& InTransform, const FLinearColor& Tint, FVector2D& OutOffset) const
+{
+	if (Transform.GetMatrix() == InTransform.GetMatrix() && ColorTable.GetTint() == Tint)
+	{
+		OutOffset = InTransform.GetTranslation() - Transform.GetTranslation();
+		return true;
+	}
+
+	return false;
+}
+
+#if WITH_OBSOLETE_CLIPPING_API
+void FImGuiDrawBatcher::CopyTranslated(const FImGuiDrawBatcher& Source, const FVector2D& Offset, const FSlateRotatedRect& InVertexClippingRect)
+#else
+void FImGuiDrawBatcher::CopyTranslated(const FImGuiDrawBatcher& Source, const FVector2D& Offset)
+#endif // WITH_OBSOLETE_CLIPPING_API
+{
+	SCOPE_CYCLE_COUNTER(STAT_ImGui_CopyTranslated);
+
+	Transform = FTransform2D{ Source.Transform.GetMatrix(), Source.Transform.GetTranslation() + Offset };
+	ClippingRect = Source.ClippingRect.OffsetBy(Offset);
+#if WITH_OBSOLETE_CLIPPING_API
+	VertexClippingRect = InVertexClippingRect;
+#endif // WITH_OBSOLETE_CLIPPING_API
+	ColorTable.SetTint(Source.ColorTable.GetTint());
+
+	BufferPool = &GetDrawBufferPool();
+	BufferPoolFrame = BufferPool->GetFrameNumber();
+
+	// Copy statistics, so they are available to the same degree as after conversion.
+	CommandsNum = Source.CommandsNum;
+	CulledCommandsNum = Source.CulledCommandsNum;
+	CulledListsNum = Source.CulledListsNum;
+	OccludedListsNum = Source.OccludedListsNum;
+	CacheHitsNum = Source.CacheHitsNum;
+	CacheMissesNum = Source.CacheMissesNum;
+
+	if (Batches.Num() < Source.BatchesNum)
+	{
+		Batches.SetNum(Source.BatchesNum);
+	}
+	BatchesNum = Source.BatchesNum;
+
+	for (int32 BatchNb = 0; BatchNb < BatchesNum; BatchNb++)
+	{
+		const FImGuiDrawBatch& SourceBatch = Source.Batches[BatchNb];
+		FImGuiDrawBatch& Batch = Batches[BatchNb];
+
+		Batch.ClippingRect = SourceBatch.ClippingRect.OffsetBy(Offset);
+		Batch.TextureId = SourceBatch.TextureId;
+		Batch.NumCommands = SourceBatch.NumCommands;
+
+		Batch.IndexBuffer = &BufferPool->AcquireIndexBuffer();
+		Batch.IndexBuffer->Append(*SourceBatch.IndexBuffer);
+
+		Batch.VertexBuffer = &BufferPool->AcquireVertexBuffer();
+		Batch.VertexBuffer->Append(*SourceBatch.VertexBuffer);
+		for (FSlateVertex& Vertex : *Batch.VertexBuffer)
+		{
+			Vertex.Position[0] += Offset.X;
+			Vertex.Position[1] += Offset.Y;
+#if WITH_OBSOLETE_CLIPPING_API
+			Vertex.ClipRect = VertexClippingRect;
+#endif // WITH_OBSOLETE_CLIPPING_API
+		}
+	}
+}
@@ -0,0 +1,231 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiDrawData.h"
+
+
+class FImGuiDrawBufferPool;
+
+
+// Slate element data built from one or more ImGui draw commands.
+struct FImGuiDrawBatch
+{
+	// Clipping rectangle in screen space (already limited to the widget's clipping rectangle).
+	FSlateRect ClippingRect;
+
+	// Texture used by all commands in this batch.
+	TextureIndex TextureId = INDEX_NONE;
+
+	// Buffers from the draw buffer pool, valid only in the frame in which batch was created.
+	TArray<FSlateVertex>* VertexBuffer = nullptr;
+	TArray<SlateIndex>* IndexBuffer = nullptr;
+
+	// Number of draw commands merged into this batch.
+	int32 NumCommands = 0;
+};
+
+// Collects draw commands from ImGui draw lists and converts them to batches that can be submitted to Slate as single
+// elements. Consecutive commands, also from different draw lists, are merged into one batch if they use the same texture
+// and either have the same clipping rectangle or their geometry is not affected by clipping. Optionally, commands with
+// axis-aligned quads can be clipped on the CPU, so they can be merged regardless of their clipping rectangles.
+class FImGuiDrawBatcher
+{
+public:
+
+#if WITH_OBSOLETE_CLIPPING_API
+	// Start a new frame. Batches from the previous frame are discarded.
+	// @param Transform - Transform from ImGui canvas to screen space
+	// @param Tint - Tint to apply to vertex colors
+	// @param ClippingRect - Widget's clipping rectangle in screen space
+	// @param VertexClippingRect - Clipping rectangle for Slate vertices
+	void Reset(const FTransform2D& Transform, const FLinearColor& Tint, const FSlateRect& ClippingRect, const FSlateRotatedRect& VertexClippingRect);
+#else
+	// Start a new frame. Batches from the previous frame are discarded.
+	// @param Transform - Transform from ImGui canvas to screen space
+	// @param Tint - Tint to apply to vertex colors
+	// @param ClippingRect - Widget's clipping rectangle in screen space
+	void Reset(const FTransform2D& Transform, const FLinearColor& Tint, const FSlateRect& ClippingRect);
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+	// Add all draw commands from the draw list. Batches are created immediately but vertex and index data are only
+	// reserved and must be converted with Convert (except for quads clipped on the CPU, which are converted here).
+	// @param DrawList - Draw list, which must stay valid and unchanged until Convert is called
+	void AddDrawList(const FImGuiDrawList& DrawList);
+
+	// Convert vertex and index data of all draw lists added since the last call. Above a threshold, different draw
+	// lists are converted in parallel (see ImGui.Render.ParallelConversion). Must be called before batches are used.
+	void Convert();
+
+#if WITH_OBSOLETE_CLIPPING_API
+	// Whether batches were converted with the given parameters, so they can be used directly.
+	bool IsConvertedWith(const FTransform2D& InTransform, const FLinearColor& Tint, const FSlateRotatedRect& InVertexClippingRect) const;
+#else
+	// Whether batches were converted with the given parameters, so they can be used directly.
+	bool IsConvertedWith(const FTransform2D& InTransform, const FLinearColor& Tint) const;
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+	// Check whether batches converted with the given parameters would differ from these batches only by translation.
+	// @param InTransform - Transform from ImGui canvas to screen space
+	// @param Tint - Tint to apply to vertex colors
+	// @param OutOffset - Receives translation from these batches to batches converted with the given parameters
+	// @returns True, if batches can be translated with CopyTranslated
+	bool GetTranslationTo(const FTransform2D& InTransform, const FLinearColor& Tint, FVector2D& OutOffset) const;
+
+#if WITH_OBSOLETE_CLIPPING_API
+	// Replace batches with a translated copy of batches from the source. This is much cheaper than converting draw lists.
+	// @param Source - Batcher with converted batches
+	// @param Offset - Translation to apply to vertices and clipping rectangles
+	// @param InVertexClippingRect - Clipping rectangle for Slate vertices
+	void CopyTranslated(const FImGuiDrawBatcher& Source, const FVector2D& Offset, const FSlateRotatedRect& InVertexClippingRect);
+#else
+	// Replace batches with a translated copy of batches from the source. This is much cheaper than converting draw lists.
+	// @param Source - Batcher with converted batches
+	// @param Offset - Translation to apply to vertices and clipping rectangles
+	void CopyTranslated(const FImGuiDrawBatcher& Source, const FVector2D& Offset);
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+	// Whether batch buffers are still valid (they are only valid in the frame in which they were created).
+	bool HasValidBuffers() const;
+
+	// Get the number of batches in this frame.
+	int32 NumBatches() const { return BatchesNum; }
+
+	// Get the batch by number.
+	const FImGuiDrawBatch& GetBatch(int32 BatchNb) const { return Batches[BatchNb]; }
+
+	// Get the number of draw commands added in this frame (before merging).
+	int32 NumCommands() const { return CommandsNum; }
+
+	// Get the number of draw commands skipped in this frame because they were outside of the clipping rectangle
+	// (including commands from culled draw lists).
+	int32 NumCulledCommands() const { return CulledCommandsNum; }
+
+	// Get the number of draw lists skipped in this frame because they were outside of the clipping rectangle.
+	int32 NumCulledDrawLists() const { return CulledListsNum; }
+
+	// Get the number of draw lists skipped in this frame because they were hidden behind opaque windows (see
+	// FImGuiDrawList::IsOccluded). Their commands are counted as culled.
+	int32 NumOccludedDrawLists() const { return OccludedListsNum; }
+
+	// Get the number of draw lists in this frame that reused vertex data converted in the previous frame.
+	int32 NumVertexCacheHits() const { return CacheHitsNum; }
+
+	// Get the number of draw lists in this frame that needed to convert their vertex data.
+	int32 NumVertexCacheMisses() const { return CacheMissesNum; }
+
+private:
+
+	// Whether the draw command can be added to the last batch, ignoring clipping.
+	bool CanMerge(const FImGuiDrawCommand& DrawCommand, int32 NumVertices) const;
+
+	// Whether the draw command can be added to the last batch, which must have the same clipping rectangle.
+	bool CanMerge(const FImGuiDrawCommand& DrawCommand, const FSlateRect& ClippingRect, int32 NumVertices) const;
+
+	FImGuiDrawBatch& AddBatch(const FImGuiDrawCommand& DrawCommand, const FSlateRect& ClippingRect);
+
+	void AddCommand(FImGuiDrawBatch& Batch, const FImGuiDrawList& DrawList, int32 StartIndex, int32 NumElements,
+		const Utilities::TRange<int32>& VertexRange);
+
+	void AddClippedQuads(FImGuiDrawBatch& Batch, const FImGuiDrawList& DrawList, int32 StartIndex, int32 NumElements,
+		const FSlateRect& ClippingRect);
+
+	// Vertex and index data of a draw command, waiting to be converted into space reserved in a batch.
+	struct FPendingCopy
+	{
+		const FImGuiDrawList* DrawList;
+		int32 BatchNb;
+
+		// Vertices to copy (can be empty if command shares vertices with previous commands) and their position in batch.
+		Utilities::TRange<int32> VertexRange;
+		int32 VertexOffset;
+
+		// Indices to copy, their position in batch and offset rebasing them to the batch vertex buffer.
+		int32 StartIndex;
+		int32 NumElements;
+		int32 IndexOffset;
+		int32 IndexRebase;
+	};
+
+	// Vertex data of a whole draw list converted in this or the previous frame, keyed by the window owning the list.
+	struct FCachedVertexData
+	{
+		TArray<FSlateVertex> VertexBuffer;
+
+		// Fingerprint of the source vertices.
+		uint64 VertexDataHash = 0;
+
+		// Conversion parameters.
+		FTransform2D Transform;
+		FLinearColor Tint;
+#if WITH_OBSOLETE_CLIPPING_API
+		FSlateRotatedRect VertexClippingRect;
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+		uint32 LastUsedFrame = 0;
+		bool bValid = false;
+	};
+
+	// Conversion data of a single draw list.
+	struct FDrawListConversion
+	{
+		const FImGuiDrawList* DrawList;
+
+		// Position of the first pending copy from this list.
+		int32 FirstCopy;
+
+		// Cache entry (only resolved in Convert, as adding entries can move existing ones).
+		uint64 CacheKey;
+		FCachedVertexData* Cache;
+
+		bool bCached;
+		bool bFillCache;
+	};
+
+	bool IsCacheValid(const FCachedVertexData& Cache, const FImGuiDrawList& DrawList) const;
+
+	// Part of a draw list's vertex data copied to the last batch.
+	struct FVertexSegment
+	{
+		const FImGuiDrawList* DrawList = nullptr;
+		Utilities::TRange<int32> SourceRange;
+		int32 BatchOffset = 0;
+	};
+
+	FTransform2D Transform;
+	FImGuiColorTable ColorTable;
+	FSlateRect ClippingRect;
+#if WITH_OBSOLETE_CLIPPING_API
+	FSlateRotatedRect VertexClippingRect;
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+	bool bSliceVertexData = true;
+	bool bMergeCommands = true;
+	bool bClipQuads = false;
+	bool bUseVertexCache = true;
+
+	// Pool providing batch buffers and the pool frame in which they were acquired.
+	FImGuiDrawBufferPool* BufferPool = nullptr;
+	uint32 BufferPoolFrame = 0;
+
+	// Batches are never removed to avoid allocations, so the number of batches in this frame is stored separately.
+	TArray<FImGuiDrawBatch> Batches;
+	int32 BatchesNum = 0;
+
+	int32 CommandsNum = 0;
+	int32 CulledCommandsNum = 0;
+	int32 CulledListsNum = 0;
+	int32 OccludedListsNum = 0;
+	int32 CacheHitsNum = 0;
+	int32 CacheMissesNum = 0;
+
+	FVertexSegment VertexSegment;
+
+	// Copies waiting for conversion and conversion data of draw lists added in this frame.
+	TArray<FPendingCopy> PendingCopies;
+	TArray<FDrawListConversion> DrawListConversions;
+	int32 PendingVerticesNum = 0;
+
+	TMap<uint64, FCachedVertexData> VertexCache;
+	uint32 FrameNb = 0;
+};
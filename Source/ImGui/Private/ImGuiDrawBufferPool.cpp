@@ -0,0 +1,48 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiDrawBufferPool.h"
+
+#include "ImGuiStats.h"
+
+
+DECLARE_MEMORY_STAT(TEXT("Draw Buffers Memory"), STAT_ImGui_DrawBuffersMemory, STATGROUP_ImGui);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Draw Buffers"), STAT_ImGui_DrawBuffers, STATGROUP_ImGui);
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> DrawBuffersTrimInterval(TEXT("ImGui.Render.DrawBuffers.TrimInterval"), 300,
+		TEXT("Number of frames after which the pool of draw buffers is trimmed to the high-water mark of that interval.\n")
+		TEXT("Buffers that were not used are released and buffers larger than their peak usage (see\n")
+		TEXT("ImGui.Render.DrawBuffers.TrimSlack) are shrunk.\n")
+		TEXT("0: disabled, buffers are never trimmed"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> DrawBuffersTrimSlack(TEXT("ImGui.Render.DrawBuffers.TrimSlack"), 50,
+		TEXT("Percentage by which the capacity of a draw buffer can exceed its peak usage in the last trim interval,\n")
+		TEXT("before the buffer is shrunk (default 50)."),
+		ECVF_Default);
+}
+
+void FImGuiDrawBufferPool::BeginFrame()
+{
+	VertexBuffers.ReleaseAll();
+	IndexBuffers.ReleaseAll();
+
+	FrameNumber++;
+
+	const int32 TrimInterval = CVars::DrawBuffersTrimInterval.GetValueOnGameThread();
+	if (TrimInterval > 0 && ++FramesSinceTrim >= TrimInterval)
+	{
+		const float MaxSlack = FMath::Max(CVars::DrawBuffersTrimSlack.GetValueOnGameThread(), 0) / 100.f;
+
+		VertexBuffers.Trim(MaxSlack);
+		IndexBuffers.Trim(MaxSlack);
+
+		FramesSinceTrim = 0;
+	}
+
+	SET_MEMORY_STAT(STAT_ImGui_DrawBuffersMemory, GetAllocatedSize());
+	SET_DWORD_STAT(STAT_ImGui_DrawBuffers, VertexBuffers.Num() + IndexBuffers.Num());
+}
@@ -0,0 +1,119 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <SlateCore.h>
+
+
+// Module-wide, frame-scoped pool of buffers for converted draw data. Buffers acquired during a frame stay valid until
+// the next BeginFrame, after which they are reused in the same order. Buffers keep their capacity between frames but
+// periodically they are trimmed to the high-water mark of the last trim interval (see ImGui.Render.DrawBuffers.*).
+// Slate only accepts vertex and index data in TArrays, so rather than a single linear block, the pool is a list of
+// arrays.
+class FImGuiDrawBufferPool
+{
+public:
+
+	FImGuiDrawBufferPool() = default;
+
+	FImGuiDrawBufferPool(const FImGuiDrawBufferPool&) = delete;
+	FImGuiDrawBufferPool& operator=(const FImGuiDrawBufferPool&) = delete;
+
+	// Get an empty vertex buffer, valid until the next frame.
+	TArray<FSlateVertex>& AcquireVertexBuffer() { return VertexBuffers.Acquire(); }
+
+	// Get an empty index buffer, valid until the next frame.
+	TArray<SlateIndex>& AcquireIndexBuffer() { return IndexBuffers.Acquire(); }
+
+	// Get the number of the current frame. Buffers acquired in different frames are no longer valid.
+	uint32 GetFrameNumber() const { return FrameNumber; }
+
+	// Release all buffers acquired in the previous frame and trim the pool, if the trim interval has elapsed.
+	void BeginFrame();
+
+	// Get the size of memory allocated by all buffers.
+	SIZE_T GetAllocatedSize() const { return VertexBuffers.GetAllocatedSize() + IndexBuffers.GetAllocatedSize(); }
+
+private:
+
+	template<typename ElementType>
+	class TBufferList
+	{
+	public:
+
+		TArray<ElementType>& Acquire()
+		{
+			if (UsedNum == Entries.Num())
+			{
+				// Entries are allocated separately, so buffers don't move when the list grows.
+				Entries.Add(MakeUnique<FEntry>());
+			}
+
+			TArray<ElementType>& Buffer = Entries[UsedNum++]->Buffer;
+			Buffer.Reset();
+			return Buffer;
+		}
+
+		// Make all buffers available again, updating high-water marks with the usage from the last frame.
+		void ReleaseAll()
+		{
+			for (int32 Index = 0; Index < UsedNum; Index++)
+			{
+				FEntry& Entry = *Entries[Index];
+				Entry.PeakNum = FMath::Max(Entry.PeakNum, Entry.Buffer.Num());
+			}
+
+			PeakUsedNum = FMath::Max(PeakUsedNum, UsedNum);
+			UsedNum = 0;
+		}
+
+		// Release buffers not used since the last trim and shrink buffers with capacity larger than their high-water
+		// mark with allowed slack. High-water marks are reset for the next interval.
+		void Trim(float MaxSlack)
+		{
+			Entries.SetNum(PeakUsedNum);
+
+			for (auto& Entry : Entries)
+			{
+				if (Entry->Buffer.Max() > Entry->PeakNum * (1.f + MaxSlack))
+				{
+					Entry->Buffer.Empty(Entry->PeakNum);
+				}
+
+				Entry->PeakNum = 0;
+			}
+
+			PeakUsedNum = 0;
+		}
+
+		int32 Num() const { return Entries.Num(); }
+
+		SIZE_T GetAllocatedSize() const
+		{
+			SIZE_T Size = 0;
+			for (const auto& Entry : Entries)
+			{
+				Size += Entry->Buffer.GetAllocatedSize();
+			}
+			return Size;
+		}
+
+	private:
+
+		struct FEntry
+		{
+			TArray<ElementType> Buffer;
+			int32 PeakNum = 0;
+		};
+
+		TArray<TUniquePtr<FEntry>> Entries;
+		int32 UsedNum = 0;
+		int32 PeakUsedNum = 0;
+	};
+
+	TBufferList<FSlateVertex> VertexBuffers;
+	TBufferList<SlateIndex> IndexBuffers;
+
+	uint32 FrameNumber = 1;
+	int32 FramesSinceTrim = 0;
+};
@@ -4,54 +4,585 @@
 
 #include "ImGuiDrawData.h"
 
+#include "ImGuiStats.h"
 
+#include <Hash/CityHash.h>
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiDrawData, Warning, All);
+
+DECLARE_CYCLE_STAT(TEXT("Convert Vertices (Reference)"), STAT_ImGui_ConvertVertices_Reference, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Convert Vertices (General)"), STAT_ImGui_ConvertVertices_General, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Convert Vertices (General, Identity Tint)"), STAT_ImGui_ConvertVertices_General_IdentityTint, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Convert Vertices (Translation)"), STAT_ImGui_ConvertVertices_Translation, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Convert Vertices (Translation, Identity Tint)"), STAT_ImGui_ConvertVertices_Translation_IdentityTint, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Convert Indices"), STAT_ImGui_ConvertIndices, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Clip Quads"), STAT_ImGui_ClipQuads, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Extract Glyph Instances"), STAT_ImGui_ExtractGlyphInstances, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Expand Glyph Instances"), STAT_ImGui_ExpandGlyphInstances, STATGROUP_ImGui);
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> VectorizedVertexConversion(TEXT("ImGui.Render.VectorizedVertexConversion"), 1,
+		TEXT("Whether ImGui vertices should be converted to Slate vertices using vectorized implementation.\n")
+		TEXT("0: disabled, vertices are converted one at a time\n")
+		TEXT("1: enabled (default), vertex positions and texture coordinates are converted four vertices per step"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> SpecializedVertexConversion(TEXT("ImGui.Render.SpecializedVertexConversion"), 1,
+		TEXT("Whether vectorized vertex conversion should use variants specialized for translation-only transforms and\n")
+		TEXT("identity tint (see 'stat ImGui' to compare timings).\n")
+		TEXT("0: disabled, general variant is used for all draw lists\n")
+		TEXT("1: enabled (default), variant is selected for every draw list"),
+		ECVF_Default);
+
+#if !UE_BUILD_SHIPPING
+	TAutoConsoleVariable<int> ValidateVertexConversion(TEXT("ImGui.Debug.ValidateVertexConversion"), 0,
+		TEXT("Whether vertex conversion should be validated against reference implementation.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled, mismatches are logged as errors (expensive)"),
+		ECVF_Default);
+#endif // !UE_BUILD_SHIPPING
+}
+
+namespace
+{
+	// Vectorized conversion loads position and texture coordinates of one vertex to a single register.
+	static_assert(STRUCT_OFFSET(ImDrawVert, uv) == STRUCT_OFFSET(ImDrawVert, pos) + sizeof(ImVec2),
+		"Vectorized vertex conversion requires ImDrawVert with texture coordinates directly following position.");
+
+	// Parameters shared by all vertices converted in one batch.
+	struct FVertexConversionContext
+	{
+		const FTransform2D& Transform;
+		const FImGuiColorTable& ColorTable;
 #if WITH_OBSOLETE_CLIPPING_API
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FWidgetStyle& WidgetStyle, const FSlateRotatedRect& VertexClippingRect) const
-#else
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FWidgetStyle& WidgetStyle) const
+		const FSlateRotatedRect& VertexClippingRect;
 #endif // WITH_OBSOLETE_CLIPPING_API
-{
-	// Reset and reserve space in destination buffer.
-	OutVertexBuffer.SetNumUninitialized(ImGuiVertexBuffer.Size, false);
+	};
 
-	// Transform and copy vertex data.
-	for (int Idx = 0; Idx < ImGuiVertexBuffer.Size; Idx++)
+	FORCEINLINE void SetPosition(FSlateVertex& SlateVertex, float X, float Y)
 	{
-		const ImDrawVert& ImGuiVertex = ImGuiVertexBuffer[Idx];
-		FSlateVertex& SlateVertex = OutVertexBuffer[Idx];
+#if WITH_OBSOLETE_CLIPPING_API
+		SlateVertex.Position[0] = X;
+		SlateVertex.Position[1] = Y;
+#else
+		SlateVertex.Position = FVector2D{ X, Y };
+#endif // WITH_OBSOLETE_CLIPPING_API
+	}
 
+	// Reference conversion of a single vertex.
+	FORCEINLINE void ConvertVertex(FSlateVertex& SlateVertex, const ImDrawVert& ImGuiVertex, const FVertexConversionContext& Context)
+	{
 		// Final UV is calculated in shader as XY * ZW, so we need set all components.
 		SlateVertex.TexCoords[0] = ImGuiVertex.uv.x;
 		SlateVertex.TexCoords[1] = ImGuiVertex.uv.y;
 		SlateVertex.TexCoords[2] = SlateVertex.TexCoords[3] = 1.f;
 
+		const FVector2D VertexPosition = Context.Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
+		SetPosition(SlateVertex, VertexPosition.X, VertexPosition.Y);
+
 #if WITH_OBSOLETE_CLIPPING_API
-		const FVector2D VertexPosition = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
-		SlateVertex.Position[0] = VertexPosition.X;
-		SlateVertex.Position[1] = VertexPosition.Y;
-		SlateVertex.ClipRect = VertexClippingRect;
-#else
-		SlateVertex.Position = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
+		SlateVertex.ClipRect = Context.VertexClippingRect;
 #endif // WITH_OBSOLETE_CLIPPING_API
 
 		// Unpack ImU32 color.
-		SlateVertex.Color = (WidgetStyle.GetColorAndOpacityTint() * ImGuiInterops::UnpackImU32Color(ImGuiVertex.col)).ToFColor(true);
+		SlateVertex.Color = Context.ColorTable.Convert(ImGuiVertex.col);
+	}
+
+	// Reference implementation converting one vertex at a time.
+	void ConvertVertices(FSlateVertex* RESTRICT Dst, const ImDrawVert* RESTRICT Src, int32 Num, const FVertexConversionContext& Context)
+	{
+		for (int32 Idx = 0; Idx < Num; Idx++)
+		{
+			ConvertVertex(Dst[Idx], Src[Idx], Context);
+		}
+	}
+
+	// Vectorized implementation converting four vertices per step. Vertex position and texture coordinates are packed
+	// in one register (X, Y, U, V) and transformed together with:
+	//   (X, X, U, V) * (M00, M01, 1, 1) + (Y, Y, Y, Y) * (M10, M11, 0, 0) + (TX, TY, 0, 0)
+	// Remaining vertices are converted with the reference implementation.
+	// @param bTranslationOnly - If true, transform matrix is assumed to be identity and only translation is applied
+	// @param bIdentityTint - If true, color table is assumed to be identity and colors are only unpacked
+	template<bool bTranslationOnly, bool bIdentityTint>
+	void ConvertVerticesVectorized(FSlateVertex* RESTRICT Dst, const ImDrawVert* RESTRICT Src, int32 Num, const FVertexConversionContext& Context)
+	{
+		float M00, M01, M10, M11;
+		Context.Transform.GetMatrix().GetMatrix(M00, M01, M10, M11);
+		const FVector2D Translation = Context.Transform.GetTranslation();
+
+		const VectorRegister MatrixRowX = MakeVectorRegister(M00, M01, 1.f, 1.f);
+		const VectorRegister MatrixRowY = MakeVectorRegister(M10, M11, 0.f, 0.f);
+		const VectorRegister Offset = MakeVectorRegister(Translation.X, Translation.Y, 0.f, 0.f);
+
+		// Texture coordinates are stored as (U, V, 1, 1).
+		const VectorRegister TexCoordsMask = MakeVectorRegister(1.f, 1.f, 0.f, 0.f);
+		const VectorRegister TexCoordsFill = MakeVectorRegister(0.f, 0.f, 1.f, 1.f);
+
+		auto Transform = [&](const VectorRegister& PosUV)
+		{
+			if (bTranslationOnly)
+			{
+				return VectorAdd(PosUV, Offset);
+			}
+			else
+			{
+				return VectorMultiplyAdd(VectorSwizzle(PosUV, 0, 0, 2, 3), MatrixRowX,
+					VectorMultiplyAdd(VectorReplicate(PosUV, 1), MatrixRowY, Offset));
+			}
+		};
+
+		auto Store = [&](FSlateVertex& SlateVertex, const ImDrawVert& ImGuiVertex, const VectorRegister& PosUV, const VectorRegister& Transformed)
+		{
+			VectorStore(VectorMultiplyAdd(VectorSwizzle(PosUV, 2, 3, 2, 3), TexCoordsMask, TexCoordsFill), SlateVertex.TexCoords);
+
+			float Position[4];
+			VectorStore(Transformed, Position);
+			SetPosition(SlateVertex, Position[0], Position[1]);
+
+#if WITH_OBSOLETE_CLIPPING_API
+			SlateVertex.ClipRect = Context.VertexClippingRect;
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+			SlateVertex.Color = bIdentityTint ? ImGuiInterops::UnpackImU32Color(ImGuiVertex.col) : Context.ColorTable.Convert(ImGuiVertex.col);
+		};
+
+		int32 Idx = 0;
+		for (; Idx + 4 <= Num; Idx += 4)
+		{
+			const VectorRegister PosUV0 = VectorLoad(&Src[Idx + 0].pos);
+			const VectorRegister PosUV1 = VectorLoad(&Src[Idx + 1].pos);
+			const VectorRegister PosUV2 = VectorLoad(&Src[Idx + 2].pos);
+			const VectorRegister PosUV3 = VectorLoad(&Src[Idx + 3].pos);
+
+			const VectorRegister Transformed0 = Transform(PosUV0);
+			const VectorRegister Transformed1 = Transform(PosUV1);
+			const VectorRegister Transformed2 = Transform(PosUV2);
+			const VectorRegister Transformed3 = Transform(PosUV3);
+
+			Store(Dst[Idx + 0], Src[Idx + 0], PosUV0, Transformed0);
+			Store(Dst[Idx + 1], Src[Idx + 1], PosUV1, Transformed1);
+			Store(Dst[Idx + 2], Src[Idx + 2], PosUV2, Transformed2);
+			Store(Dst[Idx + 3], Src[Idx + 3], PosUV3, Transformed3);
+		}
+
+		ConvertVertices(Dst + Idx, Src + Idx, Num - Idx, Context);
+	}
+
+	FORCEINLINE bool IsTranslationOnly(const FTransform2D& Transform)
+	{
+		float M00, M01, M10, M11;
+		Transform.GetMatrix().GetMatrix(M00, M01, M10, M11);
+		return M00 == 1.f && M01 == 0.f && M10 == 0.f && M11 == 1.f;
+	}
+
+	// Select vectorized variant specialized for the given context and use it to convert vertices.
+	void ConvertVerticesSpecialized(FSlateVertex* RESTRICT Dst, const ImDrawVert* RESTRICT Src, int32 Num, const FVertexConversionContext& Context)
+	{
+		const bool bSpecialize = (CVars::SpecializedVertexConversion.GetValueOnAnyThread() > 0);
+		const bool bTranslationOnly = bSpecialize && IsTranslationOnly(Context.Transform);
+		const bool bIdentityTint = bSpecialize && Context.ColorTable.IsIdentity();
+
+		if (bTranslationOnly && bIdentityTint)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ImGui_ConvertVertices_Translation_IdentityTint);
+			ConvertVerticesVectorized<true, true>(Dst, Src, Num, Context);
+		}
+		else if (bTranslationOnly)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ImGui_ConvertVertices_Translation);
+			ConvertVerticesVectorized<true, false>(Dst, Src, Num, Context);
+		}
+		else if (bIdentityTint)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ImGui_ConvertVertices_General_IdentityTint);
+			ConvertVerticesVectorized<false, true>(Dst, Src, Num, Context);
+		}
+		else
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ImGui_ConvertVertices_General);
+			ConvertVerticesVectorized<false, false>(Dst, Src, Num, Context);
+		}
+	}
+
+	// Convert indices from ImGui to Slate format. Identical formats are copied with memcpy, 16-bit indices are widened
+	// to 32-bit with vector intrinsics (eight indices per step) and all other combinations use a simple loop. When
+	// narrowing 32-bit indices to 16-bit, upper bits are discarded but since subtraction is modular, indices can be still
+	// rebased to the beginning of vertex ranges that are not larger than MaxSlateIndexedVertices.
+	void ConvertIndices(SlateIndex* RESTRICT Dst, const ImDrawIdx* RESTRICT Src, int32 Num)
+	{
+		if (sizeof(ImDrawIdx) == sizeof(SlateIndex))
+		{
+			FMemory::Memcpy(Dst, Src, Num * sizeof(SlateIndex));
+			return;
+		}
+
+		int32 Idx = 0;
+
+		if (sizeof(ImDrawIdx) == sizeof(uint16) && sizeof(SlateIndex) == sizeof(uint32))
+		{
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+			for (; Idx + 8 <= Num; Idx += 8)
+			{
+				const uint16x8_t Indices = vld1q_u16(reinterpret_cast<const uint16*>(Src + Idx));
+				vst1q_u32(reinterpret_cast<uint32*>(Dst + Idx), vmovl_u16(vget_low_u16(Indices)));
+				vst1q_u32(reinterpret_cast<uint32*>(Dst + Idx + 4), vmovl_u16(vget_high_u16(Indices)));
+			}
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+			const __m128i Zero = _mm_setzero_si128();
+			for (; Idx + 8 <= Num; Idx += 8)
+			{
+				const __m128i Indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src + Idx));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + Idx), _mm_unpacklo_epi16(Indices, Zero));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + Idx + 4), _mm_unpackhi_epi16(Indices, Zero));
+			}
+#endif // PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+		}
+
+		for (; Idx < Num; Idx++)
+		{
+			Dst[Idx] = static_cast<SlateIndex>(Src[Idx]);
+		}
+	}
+
+	// Clip a segment [A, B] with texture coordinates [UA, UB] to [Min, Max]. Segment can be reversed (A > B).
+	// @returns False, if clipped segment is empty
+	FORCEINLINE bool ClipSegment(float& A, float& B, float& UA, float& UB, float Min, float Max)
+	{
+		const float Length = B - A;
+		const float ClippedA = (Length >= 0.f) ? FMath::Max(A, Min) : FMath::Min(A, Max);
+		const float ClippedB = (Length >= 0.f) ? FMath::Min(B, Max) : FMath::Max(B, Min);
+
+		if ((Length >= 0.f) ? (ClippedA >= ClippedB) : (ClippedA <= ClippedB))
+		{
+			return false;
+		}
+
+		// Texture coordinates change linearly along the segment.
+		const float UPerUnit = (UB - UA) / Length;
+		UB = UA + (ClippedB - A) * UPerUnit;
+		UA = UA + (ClippedA - A) * UPerUnit;
+		A = ClippedA;
+		B = ClippedB;
+		return true;
+	}
+
+#if !UE_BUILD_SHIPPING
+	FORCEINLINE FVector2D GetPosition(const FSlateVertex& SlateVertex)
+	{
+		return FVector2D{ SlateVertex.Position[0], SlateVertex.Position[1] };
+	}
+
+	// Vectorized implementation uses a different order of operations, so positions are compared with a tolerance.
+	constexpr float PositionTolerance = 0.01f;
+
+	// Compare converted vertices with the output of the reference implementation. Colors are compared with the result
+	// of full conversion, without using the lookup table.
+	void ValidateVertexConversion(const FSlateVertex* Converted, const ImDrawVert* Src, int32 Num, const FVertexConversionContext& Context)
+	{
+		for (int32 Idx = 0; Idx < Num; Idx++)
+		{
+			FSlateVertex Expected;
+			ConvertVertex(Expected, Src[Idx], Context);
+			Expected.Color = (Context.ColorTable.GetTint() * ImGuiInterops::UnpackImU32Color(Src[Idx].col)).ToFColor(true);
+
+			const FSlateVertex& Actual = Converted[Idx];
+			const bool bTexCoordsEqual = FMemory::Memcmp(Expected.TexCoords, Actual.TexCoords, sizeof(Expected.TexCoords)) == 0;
+			const bool bPositionEqual = GetPosition(Expected).Equals(GetPosition(Actual), PositionTolerance);
+
+			if (!bTexCoordsEqual || !bPositionEqual || Expected.Color != Actual.Color)
+			{
+				UE_LOG(LogImGuiDrawData, Error, TEXT("Vectorized vertex conversion mismatch at vertex %d: Position = %s (expected %s), Color = %s (expected %s)."),
+					Idx, *GetPosition(Actual).ToString(), *GetPosition(Expected).ToString(), *Actual.Color.ToString(), *Expected.Color.ToString());
+				return;
+			}
+		}
+	}
+#endif // !UE_BUILD_SHIPPING
+}
+
+void FImGuiColorTable::SetTint(const FLinearColor& InTint)
+{
+	if (Tint != InTint)
+	{
+		Tint = InTint;
+
+		// Decoding from sRGB and encoding back is lossless for all 8-bit values, so opaque white tint maps colors
+		// without any changes.
+		bIsIdentity = (Tint == FLinearColor::White);
+
+		if (!bIsIdentity)
+		{
+			for (int32 Value = 0; Value < 256; Value++)
+			{
+				const uint8 Channel = static_cast<uint8>(Value);
+				const FColor Color = (Tint * FLinearColor{ FColor(Channel, Channel, Channel, Channel) }).ToFColor(true);
+				Table[0][Value] = Color.R;
+				Table[1][Value] = Color.G;
+				Table[2][Value] = Color.B;
+				Table[3][Value] = Color.A;
+			}
+		}
+	}
+}
+
+Utilities::TRange<int32> FImGuiDrawList::GetVertexRange(const int32 StartIndex, const int32 NumElements) const
+{
+	if (NumElements <= 0)
+	{
+		return {};
+	}
+
+	ImDrawIdx MinIndex = ImGuiIndexBuffer[StartIndex];
+	ImDrawIdx MaxIndex = MinIndex;
+
+	for (int i = StartIndex + 1; i < StartIndex + NumElements; i++)
+	{
+		const ImDrawIdx Index = ImGuiIndexBuffer[i];
+		MinIndex = FMath::Min(MinIndex, Index);
+		MaxIndex = FMath::Max(MaxIndex, Index);
+	}
+
+	return { static_cast<int32>(MinIndex), static_cast<int32>(MaxIndex) + 1 };
+}
+
+FSlateRect FImGuiDrawList::GetVertexBounds(const Utilities::TRange<int32>& VertexRange, const FTransform2D& Transform) const
+{
+	checkf(VertexRange.GetBegin() >= 0 && VertexRange.GetEnd() <= ImGuiVertexBuffer.Size, TEXT("Vertex range out of bounds."));
+
+	ImVec2 Min{ FLT_MAX, FLT_MAX };
+	ImVec2 Max{ -FLT_MAX, -FLT_MAX };
+
+	for (int32 Idx = VertexRange.GetBegin(); Idx < VertexRange.GetEnd(); Idx++)
+	{
+		const ImVec2& Position = ImGuiVertexBuffer[Idx].pos;
+		Min.x = FMath::Min(Min.x, Position.x);
+		Min.y = FMath::Min(Min.y, Position.y);
+		Max.x = FMath::Max(Max.x, Position.x);
+		Max.y = FMath::Max(Max.y, Position.y);
+	}
+
+	return TransformRect(Transform, FSlateRect{ Min.x, Min.y, Max.x, Max.y });
+}
+
+#if WITH_OBSOLETE_CLIPPING_API
+void FImGuiDrawList::CopyVertexData(FSlateVertex* OutVertexData, const FTransform2D& Transform, const FImGuiColorTable& ColorTable, const FSlateRotatedRect& VertexClippingRect,
+	const Utilities::TRange<int32>& VertexRange) const
+#else
+void FImGuiDrawList::CopyVertexData(FSlateVertex* OutVertexData, const FTransform2D& Transform, const FImGuiColorTable& ColorTable,
+	const Utilities::TRange<int32>& VertexRange) const
+#endif // WITH_OBSOLETE_CLIPPING_API
+{
+	checkf(VertexRange.GetBegin() >= 0 && VertexRange.GetEnd() <= ImGuiVertexBuffer.Size, TEXT("Vertex range out of bounds."));
+
+	const int32 NumVertices = VertexRange.GetEnd() - VertexRange.GetBegin();
+
+#if WITH_OBSOLETE_CLIPPING_API
+	const FVertexConversionContext Context{ Transform, ColorTable, VertexClippingRect };
+#else
+	const FVertexConversionContext Context{ Transform, ColorTable };
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+	FSlateVertex* Dst = OutVertexData;
+	const ImDrawVert* Src = ImGuiVertexBuffer.Data + VertexRange.GetBegin();
+
+	// Transform and copy vertex data.
+	if (CVars::VectorizedVertexConversion.GetValueOnAnyThread() > 0)
+	{
+		ConvertVerticesSpecialized(Dst, Src, NumVertices, Context);
+
+#if !UE_BUILD_SHIPPING
+		if (CVars::ValidateVertexConversion.GetValueOnAnyThread() > 0)
+		{
+			ValidateVertexConversion(Dst, Src, NumVertices, Context);
+		}
+#endif // !UE_BUILD_SHIPPING
+	}
+	else
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ImGui_ConvertVertices_Reference);
+		ConvertVertices(Dst, Src, NumVertices, Context);
+	}
+}
+
+bool FImGuiDrawList::IsAxisAlignedQuads(const int32 StartIndex, const int32 NumElements) const
+{
+	if (NumElements <= 0 || NumElements % 6 != 0)
+	{
+		return false;
+	}
+
+	for (int32 Idx = StartIndex; Idx < StartIndex + NumElements; Idx += 6)
+	{
+		const ImDrawIdx* Indices = ImGuiIndexBuffer.Data + Idx;
+		if (Indices[3] != Indices[0] || Indices[4] != Indices[2])
+		{
+			return false;
+		}
+
+		const ImDrawVert& V0 = ImGuiVertexBuffer[Indices[0]];
+		const ImDrawVert& V1 = ImGuiVertexBuffer[Indices[1]];
+		const ImDrawVert& V2 = ImGuiVertexBuffer[Indices[2]];
+		const ImDrawVert& V3 = ImGuiVertexBuffer[Indices[5]];
+
+		// Vertices go around the quad starting with a horizontal edge, both in position and texture space.
+		const bool bPositionAligned = V0.pos.y == V1.pos.y && V1.pos.x == V2.pos.x && V2.pos.y == V3.pos.y && V3.pos.x == V0.pos.x;
+		const bool bTexCoordsAligned = V0.uv.y == V1.uv.y && V1.uv.x == V2.uv.x && V2.uv.y == V3.uv.y && V3.uv.x == V0.uv.x;
+
+		// Clipped quads don't interpolate colors.
+		const bool bUniformColor = V0.col == V1.col && V0.col == V2.col && V0.col == V3.col;
+
+		if (!bPositionAligned || !bTexCoordsAligned || !bUniformColor)
+		{
+			return false;
+		}
 	}
+
+	return true;
 }
 
-void FImGuiDrawList::CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const
+void FImGuiGlyphInstance::Expand(const TArrayView<const FImGuiGlyphInstance>& Instances, ImDrawVert* OutVertexData, ImDrawIdx* OutIndexData)
 {
-	// Reset buffer.
-	OutIndexBuffer.SetNumUninitialized(NumElements, false);
+	SCOPE_CYCLE_COUNTER(STAT_ImGui_ExpandGlyphInstances);
+
+	ImDrawVert* RESTRICT Vertex = OutVertexData;
+	ImDrawIdx* RESTRICT Index = OutIndexData;
+	ImDrawIdx FirstVertex = 0;
 
-	// Copy elements (slow copy because of different sizes of ImDrawIdx and SlateIndex and because SlateIndex can
-	// have different size on different platforms).
-	for (int i = 0; i < NumElements; i++)
+	for (const FImGuiGlyphInstance& Instance : Instances)
 	{
-		OutIndexBuffer[i] = ImGuiIndexBuffer[StartIndex + i];
+		// Vertices go around the quad starting with a horizontal edge, like in quads generated by ImGui.
+		*Vertex++ = { { Instance.Pos0.x, Instance.Pos0.y }, { Instance.UV0.x, Instance.UV0.y }, Instance.Color };
+		*Vertex++ = { { Instance.Pos1.x, Instance.Pos0.y }, { Instance.UV1.x, Instance.UV0.y }, Instance.Color };
+		*Vertex++ = { { Instance.Pos1.x, Instance.Pos1.y }, { Instance.UV1.x, Instance.UV1.y }, Instance.Color };
+		*Vertex++ = { { Instance.Pos0.x, Instance.Pos1.y }, { Instance.UV0.x, Instance.UV1.y }, Instance.Color };
+
+		*Index++ = FirstVertex;
+		*Index++ = static_cast<ImDrawIdx>(FirstVertex + 1);
+		*Index++ = static_cast<ImDrawIdx>(FirstVertex + 2);
+		*Index++ = FirstVertex;
+		*Index++ = static_cast<ImDrawIdx>(FirstVertex + 2);
+		*Index++ = static_cast<ImDrawIdx>(FirstVertex + 3);
+
+		FirstVertex += 4;
 	}
 }
 
+void FImGuiDrawList::AppendGlyphInstances(TArray<FImGuiGlyphInstance>& OutInstances, const int32 StartIndex, const int32 NumElements) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ImGui_ExtractGlyphInstances);
+
+	checkf(StartIndex >= 0 && StartIndex + NumElements <= ImGuiIndexBuffer.Size, TEXT("Index range out of bounds."));
+
+	const int32 FirstInstance = OutInstances.AddUninitialized(NumElements / 6);
+	FImGuiGlyphInstance* RESTRICT Instance = OutInstances.GetData() + FirstInstance;
+
+	for (int32 Idx = StartIndex; Idx < StartIndex + NumElements; Idx += 6)
+	{
+		// Opposite corners define the whole quad.
+		const ImDrawVert& V0 = ImGuiVertexBuffer[ImGuiIndexBuffer[Idx + 0]];
+		const ImDrawVert& V2 = ImGuiVertexBuffer[ImGuiIndexBuffer[Idx + 2]];
+
+		*Instance++ = { V0.pos, V2.pos, V0.uv, V2.uv, V0.col };
+	}
+}
+
+#if WITH_OBSOLETE_CLIPPING_API
+int32 FImGuiDrawList::AppendClippedQuads(TArray<FSlateVertex>& OutVertexBuffer, TArray<SlateIndex>& OutIndexBuffer, const FTransform2D& Transform,
+	const FImGuiColorTable& ColorTable, const FSlateRotatedRect& VertexClippingRect, const int32 StartIndex, const int32 NumElements,
+	const FSlateRect& ClippingRect) const
+#else
+int32 FImGuiDrawList::AppendClippedQuads(TArray<FSlateVertex>& OutVertexBuffer, TArray<SlateIndex>& OutIndexBuffer, const FTransform2D& Transform,
+	const FImGuiColorTable& ColorTable, const int32 StartIndex, const int32 NumElements, const FSlateRect& ClippingRect) const
+#endif // WITH_OBSOLETE_CLIPPING_API
+{
+	SCOPE_CYCLE_COUNTER(STAT_ImGui_ClipQuads);
+
+	checkf(StartIndex >= 0 && StartIndex + NumElements <= ImGuiIndexBuffer.Size, TEXT("Index range out of bounds."));
+
+	const int32 NumQuads = NumElements / 6;
+	OutVertexBuffer.Reserve(OutVertexBuffer.Num() + NumQuads * 4);
+	OutIndexBuffer.Reserve(OutIndexBuffer.Num() + NumQuads * 6);
+
+	int32 NumAppended = 0;
+	for (int32 Idx = StartIndex; Idx < StartIndex + NumElements; Idx += 6)
+	{
+		// Opposite corners define the whole quad.
+		const ImDrawVert& V0 = ImGuiVertexBuffer[ImGuiIndexBuffer[Idx + 0]];
+		const ImDrawVert& V2 = ImGuiVertexBuffer[ImGuiIndexBuffer[Idx + 2]];
+
+		const FVector2D P0 = Transform.TransformPoint(ImGuiInterops::ToVector2D(V0.pos));
+		const FVector2D P2 = Transform.TransformPoint(ImGuiInterops::ToVector2D(V2.pos));
+
+		float X0 = P0.X, X1 = P2.X, TexU0 = V0.uv.x, TexU1 = V2.uv.x;
+		float Y0 = P0.Y, Y1 = P2.Y, TexV0 = V0.uv.y, TexV1 = V2.uv.y;
+
+		if (!ClipSegment(X0, X1, TexU0, TexU1, ClippingRect.Left, ClippingRect.Right)
+			|| !ClipSegment(Y0, Y1, TexV0, TexV1, ClippingRect.Top, ClippingRect.Bottom))
+		{
+			continue;
+		}
+
+		const FColor Color = ColorTable.Convert(V0.col);
+		const SlateIndex IndexOffset = static_cast<SlateIndex>(OutVertexBuffer.Num());
+
+		auto AddVertex = [&](float X, float Y, float TexU, float TexV)
+		{
+			FSlateVertex& SlateVertex = OutVertexBuffer[OutVertexBuffer.AddUninitialized()];
+			SlateVertex.TexCoords[0] = TexU;
+			SlateVertex.TexCoords[1] = TexV;
+			SlateVertex.TexCoords[2] = SlateVertex.TexCoords[3] = 1.f;
+			SetPosition(SlateVertex, X, Y);
+#if WITH_OBSOLETE_CLIPPING_API
+			SlateVertex.ClipRect = VertexClippingRect;
+#endif // WITH_OBSOLETE_CLIPPING_API
+			SlateVertex.Color = Color;
+		};
+
+		AddVertex(X0, Y0, TexU0, TexV0);
+		AddVertex(X1, Y0, TexU1, TexV0);
+		AddVertex(X1, Y1, TexU1, TexV1);
+		AddVertex(X0, Y1, TexU0, TexV1);
+
+		SlateIndex* Indices = OutIndexBuffer.GetData() + OutIndexBuffer.AddUninitialized(6);
+		Indices[0] = Indices[3] = IndexOffset;
+		Indices[1] = static_cast<SlateIndex>(IndexOffset + 1);
+		Indices[2] = Indices[4] = static_cast<SlateIndex>(IndexOffset + 2);
+		Indices[5] = static_cast<SlateIndex>(IndexOffset + 3);
+
+		NumAppended++;
+	}
+
+	return NumAppended;
+}
+
+void FImGuiDrawList::CopyIndexData(SlateIndex* OutIndexData, const int32 StartIndex, const int32 NumElements, const int32 VertexOffset) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ImGui_ConvertIndices);
+
+	checkf(StartIndex >= 0 && StartIndex + NumElements <= ImGuiIndexBuffer.Size, TEXT("Index range out of bounds."));
+
+	SlateIndex* RESTRICT Dst = OutIndexData;
+	ConvertIndices(Dst, ImGuiIndexBuffer.Data + StartIndex, NumElements);
+
+	if (VertexOffset != 0)
+	{
+		// Simple loop that compilers can vectorize (unsigned arithmetic handles negative offsets).
+		const SlateIndex Offset = static_cast<SlateIndex>(VertexOffset);
+		for (int32 Idx = 0; Idx < NumElements; Idx++)
+		{
+			Dst[Idx] -= Offset;
+		}
+	}
+}
+
+uint64 FImGuiDrawList::GetOwnerId(const ImDrawList& DrawList)
+{
+	// Window names are unique within a context, so they identify lists across frames.
+	return DrawList._OwnerName ? CityHash64(DrawList._OwnerName, FCStringAnsi::Strlen(DrawList._OwnerName)) : 0;
+}
+
 void FImGuiDrawList::TransferDrawData(ImDrawList& Src)
 {
 	// Move data from source to this list.
@@ -59,6 +590,26 @@ void FImGuiDrawList::TransferDrawData(ImDrawList& Src)
 	Src.IdxBuffer.swap(ImGuiIndexBuffer);
 	Src.VtxBuffer.swap(ImGuiVertexBuffer);
 
+	// Compute bounds while command data are still in cache, so rendering can cull lists without visiting commands.
+	ClippingBounds = FSlateRect{};
+	if (ImGuiCommandBuffer.Size > 0)
+	{
+		ImVec4 Bounds = ImGuiCommandBuffer[0].ClipRect;
+		for (int CommandNb = 1; CommandNb < ImGuiCommandBuffer.Size; CommandNb++)
+		{
+			const ImVec4& ClipRect = ImGuiCommandBuffer[CommandNb].ClipRect;
+			Bounds.x = FMath::Min(Bounds.x, ClipRect.x);
+			Bounds.y = FMath::Min(Bounds.y, ClipRect.y);
+			Bounds.z = FMath::Max(Bounds.z, ClipRect.z);
+			Bounds.w = FMath::Max(Bounds.w, ClipRect.w);
+		}
+		ClippingBounds = ImGuiInterops::ToSlateRect(Bounds);
+	}
+
+	// Fingerprint of vertex data, so unchanged lists can reuse vertices converted in previous frames.
+	VertexDataHash = CityHash64(reinterpret_cast<const char*>(ImGuiVertexBuffer.Data), ImGuiVertexBuffer.Size * sizeof(ImDrawVert));
+	OwnerId = GetOwnerId(Src);
+
 	// ImGui seems to clear draw lists in every frame, but since source list can contain pointers to buffers that
 	// we just swapped, it is better to clear explicitly here.
 	Src.Clear();
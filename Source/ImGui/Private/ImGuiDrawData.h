@@ -3,7 +3,9 @@
 #pragma once
 
 #include "ImGuiInteroperability.h"
+#include "Utilities/Range.h"
 
+#include <Containers/ArrayView.h>
 #include <Runtime/Launch/Resources/Version.h>
 #include <SlateCore.h>
 
@@ -14,6 +16,53 @@
 // support older engine versions.
 #define WITH_OBSOLETE_CLIPPING_API		(ENGINE_MAJOR_VERSION < 4 || (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 17))
 
+// Maximal number of vertices that can be addressed by Slate indices. On platforms where SlateIndex is narrower than
+// ImDrawIdx (16-bit Slate indices with 32-bit ImGui indices) larger draw lists need to be sliced between draw commands.
+constexpr int32 MaxSlateIndexedVertices = (sizeof(SlateIndex) < sizeof(int32)) ? (1 << (8 * sizeof(SlateIndex))) : MAX_int32;
+
+// Lookup table converting ImGui packed colors to tinted Slate colors.
+// Converting a single color requires decoding it from sRGB, multiplying by tint and encoding it back to sRGB. Since every
+// channel is converted independently, results for all 256 values of each channel can be computed once per tint.
+class FImGuiColorTable
+{
+public:
+
+	// Create a table for opaque white tint.
+	FImGuiColorTable() { SetTint(FLinearColor::White); }
+
+	// Create a table for the given tint.
+	explicit FImGuiColorTable(const FLinearColor& InTint) { SetTint(InTint); }
+
+	// Get the tint used by this table.
+	const FLinearColor& GetTint() const { return Tint; }
+
+	// Set the tint and rebuild this table if it has changed.
+	void SetTint(const FLinearColor& InTint);
+
+	// Whether this table maps colors without any changes.
+	bool IsIdentity() const { return bIsIdentity; }
+
+	// Convert from ImGui packed color to tinted Slate color.
+	FORCEINLINE FColor Convert(ImU32 Color) const
+	{
+		if (bIsIdentity)
+		{
+			return ImGuiInterops::UnpackImU32Color(Color);
+		}
+
+		return FColor{ Table[0][(Color >> IM_COL32_R_SHIFT) & 0xFF], Table[1][(Color >> IM_COL32_G_SHIFT) & 0xFF],
+			Table[2][(Color >> IM_COL32_B_SHIFT) & 0xFF], Table[3][(Color >> IM_COL32_A_SHIFT) & 0xFF] };
+	}
+
+private:
+
+	// Per-channel tables in RGBA order (not used if table is identity).
+	uint8 Table[4][256];
+
+	FLinearColor Tint = FLinearColor::Transparent;
+	bool bIsIdentity = false;
+};
+
 // ImGui draw command data transformed for Slate.
 struct FImGuiDrawCommand
 {
@@ -22,6 +71,26 @@ struct FImGuiDrawCommand
 	TextureIndex TextureId;
 };
 
+// Compact representation of an axis-aligned quad with uniform color, like a text glyph. A single instance replaces four
+// vertices and six indices.
+struct FImGuiGlyphInstance
+{
+	// Position and texture coordinates of the first corner and the opposite one.
+	ImVec2 Pos0;
+	ImVec2 Pos1;
+	ImVec2 UV0;
+	ImVec2 UV1;
+
+	ImU32 Color;
+
+	// Expand glyph instances back to vertices and indices in the same layout as generated by ImGui (two triangles per quad:
+	// 0-1-2 and 0-2-3). This is a fallback for renderers without instancing and a reference for verifying instanced output.
+	// @param Instances - Glyph instances to expand
+	// @param OutVertexData - Destination with space for four vertices per instance
+	// @param OutIndexData - Destination with space for six indices per instance (addressing vertices from OutVertexData)
+	static void Expand(const TArrayView<const FImGuiGlyphInstance>& Instances, ImDrawVert* OutVertexData, ImDrawIdx* OutIndexData);
+};
+
 // Wraps raw ImGui draw list data in utilities that transform them for Slate.
 class FImGuiDrawList
 {
@@ -41,25 +110,138 @@ public:
 			ImGuiInterops::ToTextureIndex(ImGuiCommand.TextureId) };
 	}
 
+	// Get the bounding rectangle of all clipping rectangles in this list. Since all geometry is clipped, nothing from this
+	// list can be drawn outside of that rectangle.
+	// @param Transform - Transform to apply to the bounding rectangle
+	// @returns Bounding rectangle (empty, if list has no commands)
+	FSlateRect GetClippingBounds(const FTransform2D& Transform) const
+	{
+		return TransformRect(Transform, ClippingBounds);
+	}
+
+	// Whether this list is completely hidden behind opaque windows drawn after it in the same frame (see
+	// FImGuiFrameSnapshot). Occluded lists can be skipped without any visible difference.
+	FORCEINLINE bool IsOccluded() const { return bOccluded; }
+
+	// Mark whether this list is completely hidden behind opaque windows.
+	FORCEINLINE void SetOccluded(bool bInOccluded) { bOccluded = bInOccluded; }
+
+	// Get the fingerprint of vertex data in this list, computed when data were transferred from ImGui. Used to validate
+	// vertex data cached for the owner of this list.
+	FORCEINLINE uint64 GetVertexDataHash() const { return VertexDataHash; }
+
+	// Get the identifier of the ImGui window that owns this list, or 0 if the source list had no owner.
+	FORCEINLINE uint64 GetOwnerId() const { return OwnerId; }
+
+	// Get the identifier of the ImGui window that owns the given list, or 0 if that list has no owner.
+	static uint64 GetOwnerId(const ImDrawList& DrawList);
+
+	// Get the number of vertices in this list.
+	FORCEINLINE int32 NumVertices() const { return ImGuiVertexBuffer.Size; }
+
+	// Get the number of indices in this list.
+	FORCEINLINE int32 NumIndices() const { return ImGuiIndexBuffer.Size; }
+
+	// Get raw ImGui vertex data, for renderers that can use them without conversion.
+	FORCEINLINE const ImDrawVert* GetRawVertexData() const { return ImGuiVertexBuffer.Data; }
+
+	// Get raw ImGui index data, for renderers that can use them without conversion.
+	FORCEINLINE const ImDrawIdx* GetRawIndexData() const { return ImGuiIndexBuffer.Data; }
+
+	// Get the range of all vertices in this list.
+	FORCEINLINE Utilities::TRange<int32> GetVertexRange() const { return { 0, ImGuiVertexBuffer.Size }; }
+
+	// Get the range of vertices referenced by a sequence of indices.
+	// @param StartIndex - Position of the first element in the index buffer
+	// @param NumElements - Number of elements in the sequence
+	// @returns The smallest range containing all referenced vertices (empty, if sequence has no elements)
+	Utilities::TRange<int32> GetVertexRange(const int32 StartIndex, const int32 NumElements) const;
+
+	// Get the bounding rectangle of vertices in the given range.
+	// @param VertexRange - Range of vertices
+	// @param Transform - Transform to apply to the bounding rectangle
+	// @returns The bounding rectangle of transformed vertices
+	FSlateRect GetVertexBounds(const Utilities::TRange<int32>& VertexRange, const FTransform2D& Transform) const;
+
+#if WITH_OBSOLETE_CLIPPING_API
+	// Transform and copy vertex data to target memory.
+	// @param OutVertexData - Destination with space for all vertices in the range
+	// @param Transform - Transform to apply to all vertices
+	// @param ColorTable - Table converting vertex colors
+	// @param VertexClippingRect - Clipping rectangle for transformed Slate vertices
+	// @param VertexRange - Range of vertices to copy
+	void CopyVertexData(FSlateVertex* OutVertexData, const FTransform2D& Transform, const FImGuiColorTable& ColorTable, const FSlateRotatedRect& VertexClippingRect,
+		const Utilities::TRange<int32>& VertexRange) const;
+#else
+	// Transform and copy vertex data to target memory.
+	// @param OutVertexData - Destination with space for all vertices in the range
+	// @param Transform - Transform to apply to all vertices
+	// @param ColorTable - Table converting vertex colors
+	// @param VertexRange - Range of vertices to copy
+	void CopyVertexData(FSlateVertex* OutVertexData, const FTransform2D& Transform, const FImGuiColorTable& ColorTable,
+		const Utilities::TRange<int32>& VertexRange) const;
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+	// Check whether a sequence of indices describes only axis-aligned quads with uniform colors, in the same layout as
+	// generated by ImGui for rectangles and text glyphs (two triangles per quad: 0-1-2 and 0-2-3).
+	// @param StartIndex - Position of the first element in the index buffer
+	// @param NumElements - Number of elements in the sequence
+	// @returns True, if all elements in the sequence form axis-aligned quads
+	bool IsAxisAlignedQuads(const int32 StartIndex, const int32 NumElements) const;
+
+	// Append glyph instances for a sequence of indices describing axis-aligned quads. Requires a sequence for which
+	// IsAxisAlignedQuads returns true.
+	// @param OutInstances - Destination array
+	// @param StartIndex - Position of the first element in the index buffer
+	// @param NumElements - Number of elements in the sequence
+	void AppendGlyphInstances(TArray<FImGuiGlyphInstance>& OutInstances, const int32 StartIndex, const int32 NumElements) const;
+
 #if WITH_OBSOLETE_CLIPPING_API
-	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
-	// @param OutVertexBuffer - Destination buffer
+	// Transform and append quads clipped on the CPU, trimming their positions and texture coordinates. Quads outside of
+	// the clipping rectangle are skipped. Requires a sequence for which IsAxisAlignedQuads returns true and a transform
+	// without rotation.
+	// @param OutVertexBuffer - Destination vertex buffer
+	// @param OutIndexBuffer - Destination index buffer (appended indices address vertices in OutVertexBuffer)
 	// @param Transform - Transform to apply to all vertices
+	// @param ColorTable - Table converting vertex colors
 	// @param VertexClippingRect - Clipping rectangle for transformed Slate vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FWidgetStyle& WidgetStyle, const FSlateRotatedRect& VertexClippingRect) const;
+	// @param StartIndex - Position of the first element in the index buffer
+	// @param NumElements - Number of elements in the sequence
+	// @param ClippingRect - Clipping rectangle in screen space
+	// @returns The number of appended quads
+	int32 AppendClippedQuads(TArray<FSlateVertex>& OutVertexBuffer, TArray<SlateIndex>& OutIndexBuffer, const FTransform2D& Transform,
+		const FImGuiColorTable& ColorTable, const FSlateRotatedRect& VertexClippingRect, const int32 StartIndex, const int32 NumElements,
+		const FSlateRect& ClippingRect) const;
 #else
-	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
-	// @param OutVertexBuffer - Destination buffer
+	// Transform and append quads clipped on the CPU, trimming their positions and texture coordinates. Quads outside of
+	// the clipping rectangle are skipped. Requires a sequence for which IsAxisAlignedQuads returns true and a transform
+	// without rotation.
+	// @param OutVertexBuffer - Destination vertex buffer
+	// @param OutIndexBuffer - Destination index buffer (appended indices address vertices in OutVertexBuffer)
 	// @param Transform - Transform to apply to all vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FWidgetStyle& WidgetStyle) const;
+	// @param ColorTable - Table converting vertex colors
+	// @param StartIndex - Position of the first element in the index buffer
+	// @param NumElements - Number of elements in the sequence
+	// @param ClippingRect - Clipping rectangle in screen space
+	// @returns The number of appended quads
+	int32 AppendClippedQuads(TArray<FSlateVertex>& OutVertexBuffer, TArray<SlateIndex>& OutIndexBuffer, const FTransform2D& Transform,
+		const FImGuiColorTable& ColorTable, const int32 StartIndex, const int32 NumElements, const FSlateRect& ClippingRect) const;
 #endif // WITH_OBSOLETE_CLIPPING_API
 
-	// Transform and copy index data to target buffer (old data in the target buffer are replaced).
-	// Internal index buffer contains enough data to match the sum of NumElements from all draw commands.
-	// @param OutIndexBuffer - Destination buffer
+	// Convert and copy a sub-range of index data to target memory.
+	// @param OutIndexData - Destination with space for NumElements indices
 	// @param StartIndex - Start copying source data starting from this index
 	// @param NumElements - How many elements we want to copy
-	void CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const;
+	// @param VertexOffset - Offset subtracted from every copied index to rebase it to the position of vertex data in the
+	//     destination vertex buffer (can be negative)
+	void CopyIndexData(SlateIndex* OutIndexData, const int32 StartIndex, const int32 NumElements, const int32 VertexOffset = 0) const;
+
+	// Get the size of memory allocated by buffers of this list.
+	SIZE_T GetAllocatedSize() const
+	{
+		return ImGuiCommandBuffer.Capacity * sizeof(ImDrawCmd) + ImGuiIndexBuffer.Capacity * sizeof(ImDrawIdx)
+			+ ImGuiVertexBuffer.Capacity * sizeof(ImDrawVert);
+	}
 
 	// Transfers data from ImGui source list to this object. Leaves source cleared.
 	void TransferDrawData(ImDrawList& Src);
@@ -69,4 +251,12 @@ private:
 	ImVector<ImDrawCmd> ImGuiCommandBuffer;
 	ImVector<ImDrawIdx> ImGuiIndexBuffer;
 	ImVector<ImDrawVert> ImGuiVertexBuffer;
+
+	// Union of command clipping rectangles in ImGui space.
+	FSlateRect ClippingBounds;
+
+	uint64 VertexDataHash = 0;
+	uint64 OwnerId = 0;
+
+	bool bOccluded = false;
 };
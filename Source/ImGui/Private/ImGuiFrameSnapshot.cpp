@@ -0,0 +1,184 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiFrameSnapshot.h"
+
+#include "ImGuiInteroperability.h"
+#include "ImGuiStats.h"
+
+#include <Hash/CityHash.h>
+
+
+// These only count FImGuiDrawList objects added to and removed from snapshots. Their buffers are swapped with ImGui draw
+// lists and grow inside ImGui, which is counted by 'ImGui Allocations' (see FImGuiContextManager::Tick).
+DECLARE_DWORD_COUNTER_STAT(TEXT("Draw List Objects Created"), STAT_ImGui_DrawListObjectsCreated, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Draw List Objects Released"), STAT_ImGui_DrawListObjectsReleased, STATGROUP_ImGui);
+
+namespace CVars
+{
+	TAutoConsoleVariable<float> DrawListsReserveTime(TEXT("ImGui.DrawLists.ReserveTime"), 10.f,
+		TEXT("Time in seconds for which draw lists that are no longer used (e.g. after closing windows or popups) are kept\n")
+		TEXT("in reserve together with their buffers, before they are released (default 10)."),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> DrawListsReserveBudget(TEXT("ImGui.DrawLists.ReserveBudget"), 1024,
+		TEXT("Maximal size in KB of buffers kept in reserved draw lists of a single frame snapshot (default 1024). Above\n")
+		TEXT("this budget, reserved draw lists are released regardless of time.\n")
+		TEXT("0: no reserve, draw lists are released as soon as they are no longer used"),
+		ECVF_Default);
+}
+
+void FImGuiFrameSnapshot::Update(ImDrawData* DrawData, uint32 InFrameNumber, const TArray<FSlateRect>& OpaqueRects)
+{
+	checkf(IsUnique(), TEXT("Trying to update a frame snapshot that is still referenced by consumers."));
+
+	FrameNumber = InFrameNumber;
+	DrawListsNum = DrawData ? DrawData->CmdListsCount : 0;
+
+	if (DrawData)
+	{
+		DisplaySize = ImGuiInterops::ToVector2D(DrawData->DisplaySize);
+	}
+
+	// Only allocate lists if there are not enough in reserve.
+	if (DrawListsNum > DrawLists.Num())
+	{
+		INC_DWORD_STAT_BY(STAT_ImGui_DrawListObjectsCreated, DrawListsNum - DrawLists.Num());
+		DrawLists.SetNum(DrawListsNum, false);
+		DrawListsLastUsedTime.SetNum(DrawListsNum, false);
+	}
+
+	MatchDrawListOwners(DrawData);
+
+	const double Time = FPlatformTime::Seconds();
+	for (int Index = 0; Index < DrawListsNum; Index++)
+	{
+		DrawLists[Index].TransferDrawData(*DrawData->CmdLists[Index]);
+		DrawListsLastUsedTime[Index] = Time;
+	}
+
+	UpdateContentHash();
+
+	UpdateOcclusion(OpaqueRects);
+
+	TrimDrawLists();
+}
+
+void FImGuiFrameSnapshot::MatchDrawListOwners(const ImDrawData* DrawData)
+{
+	// Transfer swaps buffers, so ImGui lists get back buffers of lists they are matched with. Matching by owners instead
+	// of positions means that windows get back their own buffers, which already have the right capacity, even when
+	// windows are reordered, opened or closed.
+	TBitArray<> Matched{ false, DrawLists.Num() };
+	for (int32 Index = 0; Index < DrawListsNum; Index++)
+	{
+		const uint64 OwnerId = FImGuiDrawList::GetOwnerId(*DrawData->CmdLists[Index]);
+		for (int32 Candidate = 0; Candidate < DrawLists.Num(); Candidate++)
+		{
+			if (!Matched[Candidate] && DrawLists[Candidate].GetOwnerId() == OwnerId)
+			{
+				// Lists before this index that are not matched yet are still free, so it is safe to swap them.
+				DrawLists.Swap(Index, Candidate);
+				DrawListsLastUsedTime.Swap(Index, Candidate);
+				Matched[Index] = true;
+				break;
+			}
+		}
+	}
+
+	// Lists without a match keep whatever is left at their positions.
+}
+
+void FImGuiFrameSnapshot::UpdateContentHash()
+{
+	// Vertex data are already hashed by draw lists, so only commands need to be added.
+	struct FCommandKey
+	{
+		uint32 NumElements;
+		int32 TextureId;
+		float ClippingRect[4];
+	};
+
+	uint64 Hash = 0;
+	for (int32 Index = 0; Index < DrawListsNum; Index++)
+	{
+		const FImGuiDrawList& DrawList = DrawLists[Index];
+		Hash = CityHash128to64({ Hash, DrawList.GetVertexDataHash() });
+
+		for (int CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
+		{
+			const FImGuiDrawCommand DrawCommand = DrawList.GetCommand(CommandNb, FTransform2D{});
+			const FCommandKey Key{ DrawCommand.NumElements, DrawCommand.TextureId,
+				{ DrawCommand.ClippingRect.Left, DrawCommand.ClippingRect.Top, DrawCommand.ClippingRect.Right, DrawCommand.ClippingRect.Bottom } };
+			Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&Key), sizeof(Key), Hash);
+		}
+	}
+
+	ContentHash = Hash;
+}
+
+void FImGuiFrameSnapshot::UpdateOcclusion(const TArray<FSlateRect>& OpaqueRects)
+{
+	OccluderRects.Reset();
+	OccludedDrawListsNum = 0;
+
+	// Lists are in z-order, so walking from the front, we only need to test each list against occluders collected so far.
+	// Nothing can be drawn outside of clipping bounds, so lists with bounds inside of any occluder are hidden.
+	for (int32 Index = DrawListsNum - 1; Index >= 0; Index--)
+	{
+		FImGuiDrawList& DrawList = DrawLists[Index];
+		const FSlateRect Bounds = DrawList.GetClippingBounds(FTransform2D{});
+
+		const bool bOccluded = OccluderRects.ContainsByPredicate([&Bounds](const FSlateRect& Occluder)
+		{
+			return Bounds.Left >= Occluder.Left && Bounds.Top >= Occluder.Top && Bounds.Right <= Occluder.Right && Bounds.Bottom <= Occluder.Bottom;
+		});
+
+		DrawList.SetOccluded(bOccluded);
+
+		if (bOccluded)
+		{
+			OccludedDrawListsNum++;
+		}
+		else if (OpaqueRects.IsValidIndex(Index) && OpaqueRects[Index].Right > OpaqueRects[Index].Left && OpaqueRects[Index].Bottom > OpaqueRects[Index].Top)
+		{
+			OccluderRects.Add(OpaqueRects[Index]);
+		}
+	}
+}
+
+void FImGuiFrameSnapshot::TrimDrawLists()
+{
+	const double MinLastUsedTime = FPlatformTime::Seconds() - CVars::DrawListsReserveTime.GetValueOnAnyThread();
+	const SIZE_T Budget = static_cast<SIZE_T>(FMath::Max(CVars::DrawListsReserveBudget.GetValueOnAnyThread(), 0)) * 1024;
+
+	SIZE_T ReservedSize = 0;
+	for (int32 Index = DrawListsNum; Index < DrawLists.Num(); Index++)
+	{
+		ReservedSize += DrawLists[Index].GetAllocatedSize();
+	}
+
+	// Reserved lists are not ordered after matching them with owners, so release the least recently used first.
+	while (DrawLists.Num() > DrawListsNum)
+	{
+		int32 Oldest = DrawListsNum;
+		for (int32 Index = DrawListsNum + 1; Index < DrawLists.Num(); Index++)
+		{
+			if (DrawListsLastUsedTime[Index] < DrawListsLastUsedTime[Oldest])
+			{
+				Oldest = Index;
+			}
+		}
+
+		if (DrawListsLastUsedTime[Oldest] >= MinLastUsedTime && ReservedSize <= Budget)
+		{
+			break;
+		}
+
+		INC_DWORD_STAT(STAT_ImGui_DrawListObjectsReleased);
+		ReservedSize -= DrawLists[Oldest].GetAllocatedSize();
+		DrawLists.RemoveAtSwap(Oldest, 1, false);
+		DrawListsLastUsedTime.RemoveAtSwap(Oldest, 1, false);
+	}
+}
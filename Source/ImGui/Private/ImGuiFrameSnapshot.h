@@ -0,0 +1,85 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiDrawData.h"
+
+#include <Containers/ArrayView.h>
+#include <Templates/RefCounting.h>
+
+#include <imgui.h>
+
+
+// Complete output of a single ImGui frame: draw lists, display size and frame number. Snapshots are published by context
+// proxies and are immutable from that point on, so they can be read from any thread without locking, as long as the
+// reader holds a reference.
+class FImGuiFrameSnapshot : public FThreadSafeRefCountedObject
+{
+public:
+
+	FImGuiFrameSnapshot() = default;
+
+	FImGuiFrameSnapshot(const FImGuiFrameSnapshot&) = delete;
+	FImGuiFrameSnapshot& operator=(const FImGuiFrameSnapshot&) = delete;
+
+	// Get the number of the ImGui frame captured in this snapshot (unique within the context, 0 if nothing was captured).
+	uint32 GetFrameNumber() const { return FrameNumber; }
+
+	// Get the size of the ImGui canvas in this frame.
+	const FVector2D& GetDisplaySize() const { return DisplaySize; }
+
+	// Get draw lists from this frame.
+	TArrayView<const FImGuiDrawList> GetDrawLists() const { return TArrayView<const FImGuiDrawList>(DrawLists.GetData(), DrawListsNum); }
+
+	// Get a fingerprint of the frame content: vertex data and draw commands of all lists. Frames with the same fingerprint
+	// produce the same output, as long as textures don't change.
+	uint64 GetContentHash() const { return ContentHash; }
+
+	// Get rectangles of opaque windows that occlude draw lists behind them (in ImGui space).
+	const TArray<FSlateRect>& GetOccluderRects() const { return OccluderRects; }
+
+	// Get the number of draw lists hidden behind opaque windows (see FImGuiDrawList::IsOccluded).
+	int32 NumOccludedDrawLists() const { return OccludedDrawListsNum; }
+
+	// Whether nobody but the owner holds a reference to this snapshot, so it can be safely updated.
+	bool IsUnique() const { return GetRefCount() == 1; }
+
+	// Capture a new frame in this snapshot. Should be only called by the owner, when the snapshot is not shared.
+	// @param DrawData - ImGui draw data from which draw lists are transferred (they are left cleared)
+	// @param InFrameNumber - Number of the captured frame
+	// @param OpaqueRects - Rectangles covered by opaque windows, one per draw list (can be empty to disable occlusion)
+	void Update(ImDrawData* DrawData, uint32 InFrameNumber, const TArray<FSlateRect>& OpaqueRects);
+
+private:
+
+	// Reorder draw lists, so the ones used in this frame are matched with ImGui lists from the same windows.
+	void MatchDrawListOwners(const ImDrawData* DrawData);
+
+	// Mark draw lists that are completely hidden behind opaque windows drawn after them.
+	void UpdateOcclusion(const TArray<FSlateRect>& OpaqueRects);
+
+	// Calculate the fingerprint of draw lists from this frame.
+	void UpdateContentHash();
+
+	// Release draw lists that were not used for longer than allowed or that exceed the memory budget.
+	void TrimDrawLists();
+
+	// Draw lists are recycled to keep their buffers when the number of lists changes. Only the first DrawListsNum lists
+	// are used in the current frame and the remaining ones are kept in reserve. Lists are matched with ImGui lists by
+	// their owners (see MatchDrawListOwners).
+	TArray<FImGuiDrawList> DrawLists;
+	TArray<double> DrawListsLastUsedTime;
+	int32 DrawListsNum = 0;
+
+	TArray<FSlateRect> OccluderRects;
+	int32 OccludedDrawListsNum = 0;
+
+	FVector2D DisplaySize = FVector2D::ZeroVector;
+
+	uint64 ContentHash = 0;
+
+	uint32 FrameNumber = 0;
+};
+
+// Reference to a published, immutable frame snapshot.
+using FImGuiFrameSnapshotRef = TRefCountPtr<const FImGuiFrameSnapshot>;
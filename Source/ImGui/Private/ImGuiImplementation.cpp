@@ -32,6 +32,37 @@
 
 namespace ImGuiImplementation
 {
+#if IMGUI_THREAD_LOCAL_CONTEXT
+	// Replaces GImGui (see imconfig.h).
+	ImGuiContext*& GetThreadLocalContext()
+	{
+		static thread_local ImGuiContext* Context = nullptr;
+		return Context;
+	}
+#endif // IMGUI_THREAD_LOCAL_CONTEXT
+
+	namespace
+	{
+		// Contexts can be ticked and rendered on workers, so the counter needs to be thread-safe.
+		FThreadSafeCounter AllocationsNum;
+
+		void* CountingAlloc(size_t Size, void* UserData)
+		{
+			AllocationsNum.Increment();
+			return MallocWrapper(Size, UserData);
+		}
+	}
+
+	void InstallCountingAllocator()
+	{
+		ImGui::SetAllocatorFunctions(&CountingAlloc, &FreeWrapper);
+	}
+
+	uint32 GetAllocationsNum()
+	{
+		return static_cast<uint32>(AllocationsNum.GetValue());
+	}
+
 	bool GetCursorData(ImGuiMouseCursor CursorType, FVector2D& OutSize, FVector2D& OutUVMin, FVector2D& OutUVMax, FVector2D& OutOutlineUVMin, FVector2D& OutOutlineUVMax)
 	{
 		ImFontAtlas* FontAtlas = ImGui::GetIO().Fonts;
@@ -51,4 +82,46 @@ namespace ImGuiImplementation
 			return false;
 		}
 	}
+
+	void GetOpaqueWindowRects(const ImDrawData& DrawData, TArray<FSlateRect>& OutRects)
+	{
+		OutRects.Init(FSlateRect{ 0.f, 0.f, 0.f, 0.f }, DrawData.CmdListsCount);
+
+		TMap<const ImDrawList*, int32> DrawListIndices;
+		DrawListIndices.Reserve(DrawData.CmdListsCount);
+		for (int32 Index = 0; Index < DrawData.CmdListsCount; Index++)
+		{
+			DrawListIndices.Add(DrawData.CmdLists[Index], Index);
+		}
+
+		ImGuiContext& Context = *GImGui;
+		for (ImGuiWindow* Window : Context.Windows)
+		{
+			const int32* DrawListIndex = DrawListIndices.Find(Window->DrawList);
+			if (!DrawListIndex || !Window->Active || Window->Collapsed || Window->DrawList->VtxBuffer.Size == 0)
+			{
+				continue;
+			}
+
+			// Background color can be overridden with SetNextWindowBgAlpha, which is not stored in window, so instead of
+			// predicting the color we check the first vertex. If anything else was drawn before background (like modal
+			// darkening), then colors won't match and window is skipped.
+			const ImU32 BackgroundColor = ImGui::GetColorU32(GetWindowBgColorIdxFromFlags(Window->Flags));
+			const ImU32 FirstVertexColor = Window->DrawList->VtxBuffer[0].col;
+			if ((BackgroundColor & IM_COL32_A_MASK) != IM_COL32_A_MASK || FirstVertexColor != BackgroundColor)
+			{
+				continue;
+			}
+
+			// Background is drawn below the title bar. Rounded corners are excluded by moving all edges inwards.
+			const float Rounding = Window->WindowRounding;
+			const FSlateRect Rect{ Window->Pos.x + Rounding, Window->Pos.y + Window->TitleBarHeight() + Rounding,
+				Window->Pos.x + Window->Size.x - Rounding, Window->Pos.y + Window->Size.y - Rounding };
+
+			if (Rect.Right > Rect.Left && Rect.Bottom > Rect.Top)
+			{
+				OutRects[*DrawListIndex] = Rect;
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -8,6 +8,20 @@
 // Gives access to selected ImGui implementation features.
 namespace ImGuiImplementation
 {
+	// Install ImGui allocator functions that count allocations, so they can be reported per frame (see 'stat ImGui').
+	// Memory is still allocated by ImGui default functions, so blocks allocated before installation can be safely freed.
+	void InstallCountingAllocator();
+
+	// Get the total number of ImGui allocations made since the counting allocator was installed (from all threads).
+	uint32 GetAllocationsNum();
+
 	// Get specific cursor data.
 	bool GetCursorData(ImGuiMouseCursor CursorType, FVector2D& OutSize, FVector2D& OutUVMin, FVector2D& OutUVMax, FVector2D& OutOutlineUVMin, FVector2D& OutOutlineUVMax);
+
+	// Get rectangles covered by opaque backgrounds of windows owning draw lists from the current context. Window is
+	// considered opaque, if its background was drawn as the first primitive in its draw list, without transparency.
+	// Rectangles exclude title bars and rounded corners. Must be called before draw lists are cleared.
+	// @param DrawData - Draw data from the current context
+	// @param OutRects - Rectangles in ImGui space, one per draw list (empty, if list doesn't belong to an opaque window)
+	void GetOpaqueWindowRects(const ImDrawData& DrawData, TArray<FSlateRect>& OutRects);
 }
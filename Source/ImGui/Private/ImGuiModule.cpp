@@ -2,6 +2,8 @@
 
 #include "ImGuiPrivatePCH.h"
 
+#include "ImGuiContextManager.h"
+#include "ImGuiImplementation.h"
 #include "ImGuiModuleManager.h"
 #include "Utilities/WorldContext.h"
 #include "Utilities/WorldContextIndex.h"
@@ -23,7 +25,10 @@ struct EDelegateCategory
 		Default,
 
 		// Multi-context draw event defined in context manager.
-		MultiContext
+		MultiContext,
+
+		// Thread-safe multi-context draw event defined in context manager.
+		ThreadSafeMultiContext
 	};
 };
 
@@ -38,6 +43,28 @@ FImGuiDelegateHandle FImGuiModule::AddMultiContextImGuiDelegate(const FImGuiDele
 	return { ImGuiModuleManager->GetContextManager().OnDrawMultiContext().Add(Delegate), EDelegateCategory::MultiContext };
 }
 
+FImGuiDelegateHandle FImGuiModule::AddThreadSafeMultiContextImGuiDelegate(const FImGuiDelegate& Delegate)
+{
+	checkf(ImGuiModuleManager, TEXT("Null pointer to internal module implementation. Is module available?"));
+
+	return { ImGuiModuleManager->GetContextManager().OnThreadSafeDrawMultiContext().Add(Delegate), EDelegateCategory::ThreadSafeMultiContext };
+}
+
+TSharedRef<FImGuiDebugQueue, ESPMode::ThreadSafe> FImGuiModule::GetDebugQueue(UWorld* World, const FName& ContextName)
+{
+	checkf(ImGuiModuleManager, TEXT("Null pointer to internal module implementation. Is module available?"));
+	check(IsInGameThread());
+
+	return ImGuiModuleManager->GetContextProxy(World, ContextName)->GetDebugQueue();
+}
+
+void FImGuiModule::SetContextUpdateRate(UWorld* World, const FName& ContextName, float UpdateRate)
+{
+	checkf(ImGuiModuleManager, TEXT("Null pointer to internal module implementation. Is module available?"));
+
+	ImGuiModuleManager->GetContextProxy(World, ContextName)->SetUpdateRate(UpdateRate);
+}
+
 void FImGuiModule::RemoveImGuiDelegate(const FImGuiDelegateHandle& Handle)
 {
 	if (ImGuiModuleManager)
@@ -46,6 +73,10 @@ void FImGuiModule::RemoveImGuiDelegate(const FImGuiDelegateHandle& Handle)
 		{
 			ImGuiModuleManager->GetContextManager().OnDrawMultiContext().Remove(Handle.Handle);
 		}
+		else if (Handle.Category == EDelegateCategory::ThreadSafeMultiContext)
+		{
+			ImGuiModuleManager->GetContextManager().OnThreadSafeDrawMultiContext().Remove(Handle.Handle);
+		}
 		else if (auto* Proxy = ImGuiModuleManager->GetContextManager().GetContextProxy(*Handle.Name))
 		{
 			Proxy->OnDraw().Remove(Handle.Handle);
@@ -55,6 +86,9 @@ void FImGuiModule::RemoveImGuiDelegate(const FImGuiDelegateHandle& Handle)
 
 void FImGuiModule::StartupModule()
 {
+	// Count ImGui allocations before anything allocates through ImGui (see 'stat ImGui').
+	ImGuiImplementation::InstallCountingAllocator();
+
 	// Create managers that implements module logic.
 
 	checkf(!ImGuiModuleManager, TEXT("Instance of the ImGui Module Manager already exists. Instance should be created only during module startup."));
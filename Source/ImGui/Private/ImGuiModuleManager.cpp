@@ -4,6 +4,7 @@
 
 #include "TextureManager.h"
 #include "ImGuiContextManager.h"
+#include "ImGuiDrawBufferPool.h"
 
 #include "ImGuiModuleManager.h"
 
@@ -18,6 +19,7 @@ FImGuiModuleManager::FImGuiModuleManager()
 {
 	ContextManager = new FImGuiContextManager();
 	TextureManager = new FTextureManager();
+	DrawBufferPool = new FImGuiDrawBufferPool();
 	// Try to register tick delegate (it may fail if Slate application isn't yet ready).
 	RegisterTick();
 
@@ -38,6 +40,9 @@ FImGuiModuleManager::~FImGuiModuleManager()
 	delete TextureManager;
 	TextureManager = nullptr;
 
+	delete DrawBufferPool;
+	DrawBufferPool = nullptr;
+
 	// Deactivate this manager.
 	ReleaseTickInitializer();
 	UnregisterTick();
@@ -133,6 +138,9 @@ void FImGuiModuleManager::Tick(float DeltaSeconds)
 		// Inform that we will update ImGui, so other subsystems can react.
 		PreImGuiUpdateEvent.Broadcast();
 
+		// Widgets are already painted, so buffers from the last frame can be reused.
+		DrawBufferPool->BeginFrame();
+
 		// Update context manager to advance all ImGui contexts to the next frame.
 		ContextManager->Tick(DeltaSeconds);
 
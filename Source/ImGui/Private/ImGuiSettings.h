@@ -33,6 +33,13 @@ public:
 	// Path to custom implementation of ImGui Input Handler.
 	const FStringClassReference& GetImGuiInputHandlerClass() const { return ImGuiInputHandlerClass; }
 
+	// Get the maximal number of ImGui frames per second, where 0 means no limit (see ImGui.UpdateRate).
+	float GetUpdateRate() const { return UpdateRate; }
+
+	// Whether contexts with limited update rate should be updated immediately after their input changes (see
+	// ImGui.UpdateRate.WakeOnInput).
+	bool ShouldWakeOnInput() const { return bWakeOnInput; }
+
 	// Delegate raised when ImGuiInputHandlerClass property has changed.
 	FSimpleMulticastDelegate OnImGuiInputHandlerClassChanged;
 
@@ -43,6 +50,16 @@ protected:
 	UPROPERTY(EditAnywhere, config, Category = "Input", meta = (MetaClass = "ImGuiInputHandler"))
 	FStringClassReference ImGuiInputHandlerClass;
 
+	// Maximal number of ImGui frames per second. Engine frames between updates reuse the last draw data and their time
+	// is passed to the next ImGui frame. If set to 0, contexts are updated in every engine frame.
+	UPROPERTY(EditAnywhere, config, Category = "Update", meta = (ClampMin = "0", UIMin = "0", UIMax = "120"))
+	float UpdateRate = 0.f;
+
+	// If enabled, contexts with limited update rate are updated immediately after their input changes, so interaction
+	// stays responsive.
+	UPROPERTY(EditAnywhere, config, Category = "Update")
+	bool bWakeOnInput = true;
+
 private:
 
 #if WITH_EDITOR
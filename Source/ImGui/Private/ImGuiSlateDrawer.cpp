@@ -0,0 +1,469 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiSlateDrawer.h"
+
+#if IMGUI_DIRECT_RENDERER
+
+#include "ImGuiInteroperability.h"
+#include "ImGuiShaders.h"
+#include "ImGuiStats.h"
+
+#include <PipelineStateCache.h>
+#include <RenderingThread.h>
+#include <RHIStaticStates.h>
+#include <RHIUtilities.h>
+
+
+DECLARE_CYCLE_STAT(TEXT("Direct Render"), STAT_ImGui_DirectRender, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Direct Draw Calls"), STAT_ImGui_DirectDrawCalls, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Glyph Instances"), STAT_ImGui_GlyphInstances, STATGROUP_ImGui);
+DECLARE_CYCLE_STAT(TEXT("Cached Output Redraw"), STAT_ImGui_CachedOutputRedraw, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached Output Redraws"), STAT_ImGui_CachedOutputRedraws, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached Output Reuses"), STAT_ImGui_CachedOutputReuses, STATGROUP_ImGui);
+
+namespace CVars
+{
+	TAutoConsoleVariable<int> GlyphInstancing(TEXT("ImGui.Render.GlyphInstancing"), 1,
+		TEXT("Whether direct renderer should draw commands consisting only of axis-aligned quads (mostly text glyphs) from\n")
+		TEXT("compact glyph instances (position and texture rectangles and color) instead of four vertices per quad.\n")
+		TEXT("0: disabled, all commands are drawn from ImGui vertices\n")
+		TEXT("1: enabled, glyph instances are expanded to quads on the GPU (default)\n")
+		TEXT("2: enabled with CPU expansion, glyph instances are expanded back to vertices before upload (for verification)"),
+		ECVF_Default);
+}
+
+namespace
+{
+	// Vertex declaration for ImDrawVert.
+	class FImGuiDrawVertexDeclaration : public FImGuiVertexDeclaration
+	{
+	public:
+
+		FImGuiDrawVertexDeclaration()
+			: FImGuiVertexDeclaration({
+				FVertexElement(0, STRUCT_OFFSET(ImDrawVert, pos), VET_Float2, 0, sizeof(ImDrawVert)),
+				FVertexElement(0, STRUCT_OFFSET(ImDrawVert, uv), VET_Float2, 1, sizeof(ImDrawVert)),
+				// ImGui packs colors in RGBA order, which matches normalized unsigned bytes (VET_Color would swap red and blue).
+				FVertexElement(0, STRUCT_OFFSET(ImDrawVert, col), VET_UByte4N, 2, sizeof(ImDrawVert)) })
+		{
+		}
+	};
+
+	// Vertex declaration for FImGuiGlyphInstance, with one element per instance.
+	class FImGuiGlyphInstanceDeclaration : public FImGuiVertexDeclaration
+	{
+	public:
+
+		FImGuiGlyphInstanceDeclaration()
+			: FImGuiVertexDeclaration({
+				FVertexElement(0, STRUCT_OFFSET(FImGuiGlyphInstance, Pos0), VET_Float4, 0, sizeof(FImGuiGlyphInstance), true),
+				FVertexElement(0, STRUCT_OFFSET(FImGuiGlyphInstance, UV0), VET_Float4, 1, sizeof(FImGuiGlyphInstance), true),
+				FVertexElement(0, STRUCT_OFFSET(FImGuiGlyphInstance, Color), VET_UByte4N, 2, sizeof(FImGuiGlyphInstance), true) })
+		{
+		}
+	};
+
+	TGlobalResource<FImGuiDrawVertexDeclaration> GImGuiDrawVertexDeclaration;
+	TGlobalResource<FImGuiGlyphInstanceDeclaration> GImGuiGlyphInstanceDeclaration;
+
+	static_assert(STRUCT_OFFSET(FImGuiGlyphInstance, Pos1) == STRUCT_OFFSET(FImGuiGlyphInstance, Pos0) + sizeof(ImVec2)
+		&& STRUCT_OFFSET(FImGuiGlyphInstance, UV1) == STRUCT_OFFSET(FImGuiGlyphInstance, UV0) + sizeof(ImVec2),
+		"Glyph instance declaration reads both corners as a single element.");
+
+	// Number of vertices that a single draw from expanded glyph instances can address.
+	constexpr int32 MaxExpandedGlyphVertices = (sizeof(ImDrawIdx) < sizeof(int32)) ? (1 << (8 * sizeof(ImDrawIdx))) : MAX_int32;
+}
+
+bool FImGuiSlateDrawer::IsSupported()
+{
+	// Under null RHI, there are no shaders and nothing would be drawn, so Slate path is used instead.
+	return !GUsingNullRHI;
+}
+
+void FImGuiSlateDrawer::SetFrame(const FImGuiFrameSnapshotRef& Frame, const FTransform2D& Transform, const FLinearColor& Tint,
+	const FSlateRect& ClippingRect, TArray<FTexture*>&& Textures, ECacheMode CacheMode)
+{
+	FDrawParams Params{ Frame, Transform, Tint, ClippingRect, MoveTemp(Textures), CVars::GlyphInstancing.GetValueOnGameThread(), CacheMode };
+
+	ENQUEUE_RENDER_COMMAND(ImGuiSetDrawerFrame)(
+		[Drawer = AsShared(), Params = MoveTemp(Params)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			Drawer->RenderThreadParams = MoveTemp(Params);
+
+			// This command is executed before Slate draws the window, so cached output can be redrawn here.
+			Drawer->UpdateCachedOutput(RHICmdList);
+		});
+}
+
+void FImGuiSlateDrawer::PrepareDrawItems(const FDrawParams& Params, int32& OutNumVertices, int32& OutNumIndices)
+{
+	DrawItems.Reset();
+	GlyphInstances.Reset();
+	UploadedLists.Reset();
+
+	OutNumVertices = 0;
+	OutNumIndices = 0;
+
+	const TArrayView<const FImGuiDrawList> DrawLists = Params.Frame->GetDrawLists();
+	for (int32 ListIndex = 0; ListIndex < DrawLists.Num(); ListIndex++)
+	{
+		const FImGuiDrawList& DrawList = DrawLists[ListIndex];
+		if (DrawList.IsOccluded())
+		{
+			continue;
+		}
+
+		const int32 FirstItem = DrawItems.Num();
+		bool bNeedsRawData = false;
+
+		int32 StartIndex = 0;
+		for (int CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
+		{
+			const FImGuiDrawCommand DrawCommand = DrawList.GetCommand(CommandNb, Params.Transform);
+			const int32 CommandStartIndex = StartIndex;
+			StartIndex += DrawCommand.NumElements;
+
+			bool bOverlapping;
+			const FSlateRect ClippingRect = DrawCommand.ClippingRect.IntersectionWith(Params.ClippingRect, bOverlapping);
+			FTexture* Texture = Params.Textures.IsValidIndex(DrawCommand.TextureId) ? Params.Textures[DrawCommand.TextureId] : nullptr;
+			if (!bOverlapping || !Texture || !Texture->TextureRHI.IsValid() || DrawCommand.NumElements == 0)
+			{
+				continue;
+			}
+
+			FDrawItem& Item = DrawItems[DrawItems.AddDefaulted()];
+			Item.ClippingRect = ClippingRect;
+			Item.Texture = Texture;
+
+			if (Params.GlyphInstancing > 0 && DrawList.IsAxisAlignedQuads(CommandStartIndex, DrawCommand.NumElements))
+			{
+				Item.FirstInstance = GlyphInstances.Num();
+				Item.NumInstances = DrawCommand.NumElements / 6;
+				DrawList.AppendGlyphInstances(GlyphInstances, CommandStartIndex, DrawCommand.NumElements);
+			}
+			else
+			{
+				// For now relative to this list.
+				Item.NumVertices = DrawList.NumVertices();
+				Item.StartIndex = CommandStartIndex;
+				Item.NumElements = DrawCommand.NumElements;
+				bNeedsRawData = true;
+			}
+		}
+
+		// Lists drawn only from glyph instances don't need their raw data.
+		if (bNeedsRawData)
+		{
+			for (int32 ItemIndex = FirstItem; ItemIndex < DrawItems.Num(); ItemIndex++)
+			{
+				FDrawItem& Item = DrawItems[ItemIndex];
+				if (Item.NumInstances == 0)
+				{
+					Item.BaseVertexIndex = OutNumVertices;
+					Item.StartIndex += OutNumIndices;
+				}
+			}
+
+			UploadedLists.Add(ListIndex);
+			OutNumVertices += DrawList.NumVertices();
+			OutNumIndices += DrawList.NumIndices();
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_ImGui_GlyphInstances, GlyphInstances.Num());
+}
+
+void FImGuiSlateDrawer::DrawRenderThread(FRHICommandListImmediate& RHICmdList, const void* InWindowBackBuffer)
+{
+	check(IsInRenderingThread());
+
+	SCOPE_CYCLE_COUNTER(STAT_ImGui_DirectRender);
+
+	const FDrawParams& Params = RenderThreadParams;
+	if (!Params.Frame.IsValid() || !IsSupported())
+	{
+		return;
+	}
+
+	const FTexture2DRHIRef& BackBuffer = *static_cast<const FTexture2DRHIRef*>(InWindowBackBuffer);
+
+	if (Params.CacheMode != ECacheMode::None)
+	{
+		DrawCachedOutput(RHICmdList, BackBuffer->GetSizeXY());
+	}
+	else
+	{
+		DrawFrame(RHICmdList, Params, BackBuffer->GetSizeXY(), FIntPoint::ZeroValue);
+	}
+}
+
+void FImGuiSlateDrawer::UpdateCachedOutput(FRHICommandListImmediate& RHICmdList)
+{
+	check(IsInRenderingThread());
+
+	const FDrawParams& Params = RenderThreadParams;
+	if (Params.CacheMode == ECacheMode::None || !Params.Frame.IsValid() || !IsSupported())
+	{
+		CachedOutput.SafeRelease();
+		return;
+	}
+
+	// Nothing is drawn outside of the clipping rectangle, so that is the only area that needs to be cached.
+	const FIntPoint Min{ FMath::FloorToInt(Params.ClippingRect.Left), FMath::FloorToInt(Params.ClippingRect.Top) };
+	const FIntPoint Max{ FMath::CeilToInt(Params.ClippingRect.Right), FMath::CeilToInt(Params.ClippingRect.Bottom) };
+	const FIntPoint Size{ FMath::Min(Max.X - Min.X, static_cast<int32>(GMaxTextureDimensions)),
+		FMath::Min(Max.Y - Min.Y, static_cast<int32>(GMaxTextureDimensions)) };
+
+	if (Size.X <= 0 || Size.Y <= 0)
+	{
+		CachedOutput.SafeRelease();
+		return;
+	}
+
+	bool bRedraw = (Params.CacheMode == ECacheMode::Redraw) || (Min != CachedOutputRect.Min);
+	if (!CachedOutput.IsValid() || CachedOutput->GetSizeXY() != Size)
+	{
+		FRHIResourceCreateInfo CreateInfo;
+		CreateInfo.ClearValueBinding = FClearValueBinding::Transparent;
+		CachedOutput = RHICreateTexture2D(Size.X, Size.Y, PF_B8G8R8A8, 1, 1, TexCreate_RenderTargetable | TexCreate_ShaderResource, CreateInfo);
+		bRedraw = true;
+	}
+
+	CachedOutputRect = FIntRect{ Min, Min + Size };
+
+	if (bRedraw)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ImGui_CachedOutputRedraw);
+
+		// Drawing with standard blending to a transparent target leaves colors premultiplied by alpha.
+		SetRenderTarget(RHICmdList, CachedOutput, FTextureRHIRef(), ESimpleRenderTargetMode::EClearColorExistingDepth);
+		DrawFrame(RHICmdList, Params, Size, Min);
+		RHICmdList.CopyToResolveTarget(CachedOutput, CachedOutput, true, FResolveParams());
+
+		INC_DWORD_STAT(STAT_ImGui_CachedOutputRedraws);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_ImGui_CachedOutputReuses);
+	}
+}
+
+void FImGuiSlateDrawer::DrawCachedOutput(FRHICommandListImmediate& RHICmdList, const FIntPoint& TargetSize)
+{
+	if (!CachedOutput.IsValid())
+	{
+		return;
+	}
+
+	// Cached output is presented as a single glyph instance covering the whole texture.
+	const FImGuiGlyphInstance Instance{
+		ImVec2{ static_cast<float>(CachedOutputRect.Min.X), static_cast<float>(CachedOutputRect.Min.Y) },
+		ImVec2{ static_cast<float>(CachedOutputRect.Max.X), static_cast<float>(CachedOutputRect.Max.Y) },
+		ImVec2{ 0.f, 0.f }, ImVec2{ 1.f, 1.f }, IM_COL32_WHITE };
+
+	FRHIResourceCreateInfo CreateInfo;
+	FVertexBufferRHIRef InstanceBuffer = RHICreateVertexBuffer(sizeof(Instance), BUF_Volatile, CreateInfo);
+	FMemory::Memcpy(RHILockVertexBuffer(InstanceBuffer, 0, sizeof(Instance), RLM_WriteOnly), &Instance, sizeof(Instance));
+	RHIUnlockVertexBuffer(InstanceBuffer);
+
+	TShaderMapRef<FImGuiGlyphVS> GlyphVertexShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+	TShaderMapRef<FImGuiPS> PixelShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+
+	RHICmdList.SetViewport(0, 0, 0.f, TargetSize.X, TargetSize.Y, 1.f);
+
+	// Cached colors are premultiplied by alpha.
+	FGraphicsPipelineStateInitializer GraphicsPSOInit;
+	RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+	GraphicsPSOInit.BlendState = TStaticBlendState<CW_RGBA, BO_Add, BF_One, BF_InverseSourceAlpha, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+	GraphicsPSOInit.RasterizerState = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+	GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+	GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GImGuiGlyphInstanceDeclaration.VertexDeclarationRHI;
+	GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*GlyphVertexShader);
+	GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+	GraphicsPSOInit.PrimitiveType = PT_TriangleStrip;
+	SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+	// Tint is already applied, so it can only be white here.
+	GlyphVertexShader->SetParameters(RHICmdList, FVector2D{ 2.f / TargetSize.X, -2.f / TargetSize.Y }, FVector2D{ -1.f, 1.f });
+	PixelShader->SetTint(RHICmdList, FLinearColor::White);
+	PixelShader->SetTexture(RHICmdList, CachedOutput, TStaticSamplerState<SF_Point>::GetRHI());
+
+	RHICmdList.SetScissorRect(false, 0, 0, 0, 0);
+	RHICmdList.SetStreamSource(0, InstanceBuffer, 0);
+	RHICmdList.DrawPrimitive(PT_TriangleStrip, 0, 2, 1);
+
+	INC_DWORD_STAT(STAT_ImGui_DirectDrawCalls);
+}
+
+void FImGuiSlateDrawer::DrawFrame(FRHICommandListImmediate& RHICmdList, const FDrawParams& Params, const FIntPoint& TargetSize,
+	const FIntPoint& TargetOffset)
+{
+	int32 NumRawVertices, NumRawIndices;
+	PrepareDrawItems(Params, NumRawVertices, NumRawIndices);
+
+	if (DrawItems.Num() == 0)
+	{
+		return;
+	}
+
+	// In CPU expansion mode, glyph instances are expanded after raw data and drawn like any other geometry.
+	const bool bExpandGlyphs = (Params.GlyphInstancing == 2);
+	const int32 NumVertices = NumRawVertices + (bExpandGlyphs ? GlyphInstances.Num() * 4 : 0);
+	const int32 NumIndices = NumRawIndices + (bExpandGlyphs ? GlyphInstances.Num() * 6 : 0);
+
+	FRHIResourceCreateInfo CreateInfo;
+
+	// Upload raw data of lists that need them, without any conversion.
+	FVertexBufferRHIRef VertexBuffer;
+	FIndexBufferRHIRef IndexBuffer;
+	if (NumVertices > 0 && NumIndices > 0)
+	{
+		VertexBuffer = RHICreateVertexBuffer(NumVertices * sizeof(ImDrawVert), BUF_Volatile, CreateInfo);
+		IndexBuffer = RHICreateIndexBuffer(sizeof(ImDrawIdx), NumIndices * sizeof(ImDrawIdx), BUF_Volatile, CreateInfo);
+
+		ImDrawVert* VertexData = static_cast<ImDrawVert*>(RHILockVertexBuffer(VertexBuffer, 0, NumVertices * sizeof(ImDrawVert), RLM_WriteOnly));
+		ImDrawIdx* IndexData = static_cast<ImDrawIdx*>(RHILockIndexBuffer(IndexBuffer, 0, NumIndices * sizeof(ImDrawIdx), RLM_WriteOnly));
+
+		const TArrayView<const FImGuiDrawList> DrawLists = Params.Frame->GetDrawLists();
+		for (const int32 ListIndex : UploadedLists)
+		{
+			const FImGuiDrawList& DrawList = DrawLists[ListIndex];
+			FMemory::Memcpy(VertexData, DrawList.GetRawVertexData(), DrawList.NumVertices() * sizeof(ImDrawVert));
+			FMemory::Memcpy(IndexData, DrawList.GetRawIndexData(), DrawList.NumIndices() * sizeof(ImDrawIdx));
+			VertexData += DrawList.NumVertices();
+			IndexData += DrawList.NumIndices();
+		}
+
+		if (bExpandGlyphs)
+		{
+			int32 VertexOffset = NumRawVertices;
+			int32 IndexOffset = NumRawIndices;
+			for (FDrawItem& Item : DrawItems)
+			{
+				if (Item.NumInstances > 0)
+				{
+					checkf(Item.NumInstances * 4 <= MaxExpandedGlyphVertices, TEXT("Too many glyphs to expand in a single draw."));
+
+					FImGuiGlyphInstance::Expand(TArrayView<const FImGuiGlyphInstance>(GlyphInstances.GetData() + Item.FirstInstance, Item.NumInstances),
+						VertexData, IndexData);
+
+					Item.BaseVertexIndex = VertexOffset;
+					Item.NumVertices = Item.NumInstances * 4;
+					Item.StartIndex = IndexOffset;
+					Item.NumElements = Item.NumInstances * 6;
+					Item.NumInstances = 0;
+
+					VertexData += Item.NumVertices;
+					IndexData += Item.NumElements;
+					VertexOffset += Item.NumVertices;
+					IndexOffset += Item.NumElements;
+				}
+			}
+		}
+
+		RHIUnlockVertexBuffer(VertexBuffer);
+		RHIUnlockIndexBuffer(IndexBuffer);
+	}
+
+	// Upload glyph instances.
+	FVertexBufferRHIRef InstanceBuffer;
+	if (!bExpandGlyphs && GlyphInstances.Num() > 0)
+	{
+		const uint32 Size = GlyphInstances.Num() * sizeof(FImGuiGlyphInstance);
+		InstanceBuffer = RHICreateVertexBuffer(Size, BUF_Volatile, CreateInfo);
+		FMemory::Memcpy(RHILockVertexBuffer(InstanceBuffer, 0, Size, RLM_WriteOnly), GlyphInstances.GetData(), Size);
+		RHIUnlockVertexBuffer(InstanceBuffer);
+	}
+
+	TShaderMapRef<FImGuiVS> VertexShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+	TShaderMapRef<FImGuiGlyphVS> GlyphVertexShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+	TShaderMapRef<FImGuiPS> PixelShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+
+	RHICmdList.SetViewport(0, 0, 0.f, TargetSize.X, TargetSize.Y, 1.f);
+
+	// Combine transform from ImGui canvas to screen space with transform from screen to clip space of the target.
+	const FVector2D Origin = Params.Transform.TransformPoint(FVector2D::ZeroVector);
+	const FVector2D Scale = Params.Transform.TransformPoint(FVector2D::UnitVector) - Origin;
+	const FVector2D ClipScale{ 2.f / TargetSize.X, -2.f / TargetSize.Y };
+	const FVector2D ClipOffset = (Origin - FVector2D{ TargetOffset }) * ClipScale + FVector2D{ -1.f, 1.f };
+
+	// Items are drawn in ImGui order, switching between pipelines when necessary.
+	auto SetPipeline = [&](bool bInstanced)
+	{
+		FGraphicsPipelineStateInitializer GraphicsPSOInit;
+		RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+		GraphicsPSOInit.BlendState = TStaticBlendState<CW_RGBA, BO_Add, BF_SourceAlpha, BF_InverseSourceAlpha, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+		GraphicsPSOInit.RasterizerState = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+		GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+		GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+
+		if (bInstanced)
+		{
+			GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GImGuiGlyphInstanceDeclaration.VertexDeclarationRHI;
+			GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*GlyphVertexShader);
+			GraphicsPSOInit.PrimitiveType = PT_TriangleStrip;
+			SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+			GlyphVertexShader->SetParameters(RHICmdList, Scale * ClipScale, ClipOffset);
+		}
+		else
+		{
+			GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GImGuiDrawVertexDeclaration.VertexDeclarationRHI;
+			GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+			GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+			SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+			VertexShader->SetParameters(RHICmdList, Scale * ClipScale, ClipOffset);
+			RHICmdList.SetStreamSource(0, VertexBuffer, 0);
+		}
+
+		// Tint is applied directly to sRGB colors, which is an approximation of conversion done in the Slate path.
+		PixelShader->SetTint(RHICmdList, Params.Tint);
+	};
+
+	bool bPipelineSet = false;
+	bool bInstancedPipeline = false;
+	FTexture* LastTexture = nullptr;
+
+	for (const FDrawItem& Item : DrawItems)
+	{
+		const bool bInstanced = (Item.NumInstances > 0);
+		if (!bPipelineSet || bInstanced != bInstancedPipeline)
+		{
+			SetPipeline(bInstanced);
+			bPipelineSet = true;
+			bInstancedPipeline = bInstanced;
+			LastTexture = nullptr;
+		}
+
+		if (Item.Texture != LastTexture)
+		{
+			PixelShader->SetTexture(RHICmdList, Item.Texture->TextureRHI, Item.Texture->SamplerStateRHI);
+			LastTexture = Item.Texture;
+		}
+
+		RHICmdList.SetScissorRect(true,
+			FMath::Clamp(FMath::FloorToInt(Item.ClippingRect.Left) - TargetOffset.X, 0, TargetSize.X),
+			FMath::Clamp(FMath::FloorToInt(Item.ClippingRect.Top) - TargetOffset.Y, 0, TargetSize.Y),
+			FMath::Clamp(FMath::CeilToInt(Item.ClippingRect.Right) - TargetOffset.X, 0, TargetSize.X),
+			FMath::Clamp(FMath::CeilToInt(Item.ClippingRect.Bottom) - TargetOffset.Y, 0, TargetSize.Y));
+
+		if (bInstanced)
+		{
+			// Four vertices per instance are generated in the vertex shader.
+			RHICmdList.SetStreamSource(0, InstanceBuffer, Item.FirstInstance * sizeof(FImGuiGlyphInstance));
+			RHICmdList.DrawPrimitive(PT_TriangleStrip, 0, 2, Item.NumInstances);
+		}
+		else
+		{
+			RHICmdList.DrawIndexedPrimitive(IndexBuffer, PT_TriangleList, Item.BaseVertexIndex, 0, Item.NumVertices, Item.StartIndex,
+				Item.NumElements / 3, 1);
+		}
+
+		INC_DWORD_STAT(STAT_ImGui_DirectDrawCalls);
+	}
+
+	RHICmdList.SetScissorRect(false, 0, 0, 0, 0);
+}
+
+#endif // IMGUI_DIRECT_RENDERER
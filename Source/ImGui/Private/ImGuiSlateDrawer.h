@@ -0,0 +1,113 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+// Direct renderer is only compiled in engines that support it (see ImGuiShaders.Build.cs).
+#if IMGUI_DIRECT_RENDERER
+
+#include "ImGuiFrameSnapshot.h"
+
+#include <Rendering/RenderingCommon.h>
+#include <SlateCore.h>
+
+
+class FTexture;
+
+// Custom Slate element drawing ImGui frames directly on the render thread. Unlike batches submitted with
+// MakeCustomVerts, frames are not converted to Slate vertices: raw ImGui vertex and index data from a frame snapshot are
+// uploaded to dynamic buffers and drawn with dedicated shaders (see ImGuiShaders module). Commands consisting only of
+// axis-aligned quads (mostly text) can be drawn as glyph instances (see ImGui.Render.GlyphInstancing). Frames can be also
+// drawn to a render target cached between frames and presented as a single quad (see ImGui.Render.CachedOutput). Only
+// transforms with scale and translation are supported.
+class FImGuiSlateDrawer : public ICustomSlateElement, public TSharedFromThis<FImGuiSlateDrawer, ESPMode::ThreadSafe>
+{
+public:
+
+	// How to use the cached output.
+	enum class ECacheMode : uint8
+	{
+		// Draw frame directly and release cached output.
+		None,
+		// Draw frame to cached output and present it.
+		Redraw,
+		// Present cached output without drawing the frame, unless the cache is not valid.
+		Reuse
+	};
+
+	// Whether this renderer can be used with the current RHI.
+	static bool IsSupported();
+
+	// Set the frame and parameters for the next draw. Parameters are passed to the render thread in a render command,
+	// so they are in sync with Slate draw elements added in the same game frame.
+	// @param Frame - Frame snapshot to draw
+	// @param Transform - Transform from ImGui canvas to screen space
+	// @param Tint - Tint to apply to vertex colors
+	// @param ClippingRect - Clipping rectangle in screen space
+	// @param Textures - Texture resources indexed by ImGui texture ids
+	// @param CacheMode - Whether frame should be drawn directly or through the cached output
+	void SetFrame(const FImGuiFrameSnapshotRef& Frame, const FTransform2D& Transform, const FLinearColor& Tint, const FSlateRect& ClippingRect,
+		TArray<FTexture*>&& Textures, ECacheMode CacheMode = ECacheMode::None);
+
+	virtual void DrawRenderThread(FRHICommandListImmediate& RHICmdList, const void* InWindowBackBuffer) override;
+
+private:
+
+	struct FDrawParams
+	{
+		FImGuiFrameSnapshotRef Frame;
+		FTransform2D Transform;
+		FLinearColor Tint;
+		FSlateRect ClippingRect;
+		TArray<FTexture*> Textures;
+		int32 GlyphInstancing = 0;
+		ECacheMode CacheMode = ECacheMode::None;
+	};
+
+	// Draw command prepared for rendering. Depending on the mode, it is either drawn from indexed vertices or from glyph
+	// instances.
+	struct FDrawItem
+	{
+		FSlateRect ClippingRect;
+		FTexture* Texture = nullptr;
+
+		int32 BaseVertexIndex = 0;
+		int32 NumVertices = 0;
+		int32 StartIndex = 0;
+		int32 NumElements = 0;
+
+		int32 FirstInstance = 0;
+		int32 NumInstances = 0;
+	};
+
+	// Prepare draw items in ImGui order and extract glyph instances. Lists that need their raw data uploaded are added
+	// to UploadedLists and items drawn from raw data address them as if they were in one buffer.
+	void PrepareDrawItems(const FDrawParams& Params, int32& OutNumVertices, int32& OutNumIndices);
+
+	// Draw frame to the current render target.
+	// @param RHICmdList - Command list
+	// @param Params - Draw parameters with the frame to draw
+	// @param TargetSize - Size of the render target
+	// @param TargetOffset - Position of the render target in screen space
+	void DrawFrame(FRHICommandListImmediate& RHICmdList, const FDrawParams& Params, const FIntPoint& TargetSize, const FIntPoint& TargetOffset);
+
+	// Redraw cached output if requested by the current parameters or if it is not valid. Called outside of Slate
+	// rendering, so render targets can be switched.
+	void UpdateCachedOutput(FRHICommandListImmediate& RHICmdList);
+
+	// Present cached output as a single quad.
+	void DrawCachedOutput(FRHICommandListImmediate& RHICmdList, const FIntPoint& TargetSize);
+
+	// Parameters owned by the render thread.
+	FDrawParams RenderThreadParams;
+
+	// Render thread buffers, reused between frames.
+	TArray<FDrawItem> DrawItems;
+	TArray<FImGuiGlyphInstance> GlyphInstances;
+	TArray<int32> UploadedLists;
+
+	// Render target with cached output, covering CachedOutputRect in screen space.
+	FTexture2DRHIRef CachedOutput;
+	FIntRect CachedOutputRect;
+};
+
+#endif // IMGUI_DIRECT_RENDERER
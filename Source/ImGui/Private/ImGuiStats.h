@@ -0,0 +1,9 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Stats/Stats.h>
+
+
+// Stats group for ImGui module (use 'stat ImGui' console command to display them).
+DECLARE_STATS_GROUP(TEXT("ImGui"), STATGROUP_ImGui, STATCAT_Advanced);
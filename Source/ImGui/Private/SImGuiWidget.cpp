@@ -12,12 +12,14 @@
 #include "ImGuiInteroperability.h"
 #include "ImGuiModuleManager.h"
 #include "ImGuiSettings.h"
+#include "ImGuiSlateDrawer.h"
 #include "TextureManager.h"
 #include "Utilities/Arrays.h"
 #include "Utilities/ScopeGuards.h"
 #include "ImGuiUtils.h"
 
 #include <Engine/Console.h>
+#include <Hash/CityHash.h>
 
 #include <utility>
 
@@ -60,6 +62,45 @@ namespace CVars
 		TEXT("1: enabled"),
 		ECVF_Default);
 
+	TAutoConsoleVariable<int> DebugLargeDrawList(TEXT("ImGui.Debug.LargeDrawList"), 0,
+		TEXT("Show a window rendering a single draw list with a large number of vertices (more than 100k if ImGui is\n")
+		TEXT("built with 32-bit indices, otherwise limited to what 16-bit indices can address).\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> DebugOcclusionCulling(TEXT("ImGui.Debug.OcclusionCulling"), 0,
+		TEXT("Show rectangles of opaque windows used for occlusion culling (green) and bounds of draw lists hidden behind\n")
+		TEXT("them (red), using the last rendered frame.\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> DirectRenderer(TEXT("ImGui.Render.DirectRenderer"), 0,
+		TEXT("Whether ImGui output should be drawn directly on the render thread, using a custom Slate element that uploads\n")
+		TEXT("raw ImGui vertex and index data and draws them with dedicated shaders. Falls back to Slate vertices if RHI\n")
+		TEXT("doesn't support it (e.g. with -nullrhi) or if it is not compiled (it requires UE 4.21 or later, see\n")
+		TEXT("ImGuiShaders.Build.cs).\n")
+		TEXT("0: disabled, ImGui output is converted to Slate vertices (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int> CachedOutput(TEXT("ImGui.Render.CachedOutput"), 0,
+		TEXT("Whether ImGui output should be drawn to a render target cached between frames and presented as a single quad.\n")
+		TEXT("Cache is only redrawn when frame fingerprint (draw data, display size, transform, tint and clipping) changes\n")
+		TEXT("or when it gets older than ImGui.Render.CachedOutput.MaxStaleness. Uses direct renderer resources, so it falls\n")
+		TEXT("back to Slate vertices if RHI doesn't support them or if the direct renderer is not compiled (it requires\n")
+		TEXT("UE 4.21 or later, see ImGuiShaders.Build.cs).\n")
+		TEXT("0: disabled (default)\n")
+		TEXT("1: enabled"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CachedOutputMaxStaleness(TEXT("ImGui.Render.CachedOutput.MaxStaleness"), 1.f,
+		TEXT("Maximal time in seconds for which cached output can be presented without redrawing, even if frame fingerprint\n")
+		TEXT("doesn't change (default 1). Limits how long changes not covered by fingerprint, like updated textures, can be\n")
+		TEXT("missed.\n")
+		TEXT("0: no limit, cache is only redrawn when fingerprint changes"),
+		ECVF_Default);
 }
 
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
@@ -96,6 +137,7 @@ void SImGuiWidget::SetContextProxy(FImGuiContextProxy * InContextProxy)
 	if (ContextProxy != nullptr)
 	{
 		ContextProxy->OnDraw().RemoveAll(this);
+		ContextProxy->OnFrameChanged().RemoveAll(this);
 	}
 
 	ContextProxy = InContextProxy;
@@ -103,6 +145,10 @@ void SImGuiWidget::SetContextProxy(FImGuiContextProxy * InContextProxy)
 	if (ContextProxy != nullptr)
 	{
 		ContextProxy->OnDraw().AddRaw(this, &SImGuiWidget::OnDebugDraw);
+		ContextProxy->OnFrameChanged().AddRaw(this, &SImGuiWidget::OnFrameChanged);
+
+		// Paint cached for the previous context is no longer valid.
+		Invalidate(EInvalidateWidget::Layout);
 	}
 }
 
@@ -500,6 +546,39 @@ namespace
 		OutIndexBuffer.Append({ IndexOffset + 0U, IndexOffset + 1U, IndexOffset + 2U, IndexOffset + 0U, IndexOffset + 2U, IndexOffset + 3U });
 	}
 #endif // WITH_OBSOLETE_CLIPPING_API
+
+	// Direct renderer and cached output fall back to Slate vertices, so log once to make it visible.
+	void WarnDirectRendererFallback()
+	{
+		static bool bIsWarningLogged = false;
+		if (!bIsWarningLogged)
+		{
+			bIsWarningLogged = true;
+#if IMGUI_DIRECT_RENDERER
+			UE_LOG(LogImGuiWidget, Warning, TEXT("ImGui.Render.DirectRenderer and ImGui.Render.CachedOutput are ignored, because RHI ")
+				TEXT("doesn't support the direct renderer. ImGui output is converted to Slate vertices."));
+#else
+			UE_LOG(LogImGuiWidget, Warning, TEXT("ImGui.Render.DirectRenderer and ImGui.Render.CachedOutput are ignored, because the ")
+				TEXT("direct renderer is not compiled (it requires UE 4.21 or later, see ImGuiShaders.Build.cs). ImGui output is ")
+				TEXT("converted to Slate vertices."));
+#endif // IMGUI_DIRECT_RENDERER
+		}
+	}
+
+#if IMGUI_DIRECT_RENDERER
+	// Fingerprint of everything that affects output drawn from a frame, except for texture content.
+	uint64 GetOutputFingerprint(const FImGuiFrameSnapshot& Frame, const FTransform2D& Transform, const FLinearColor& Tint, const FSlateRect& ClippingRect)
+	{
+		const FVector2D Origin = Transform.TransformPoint(FVector2D::ZeroVector);
+		const FVector2D Scale = Transform.TransformPoint(FVector2D::UnitVector) - Origin;
+		const FVector2D& DisplaySize = Frame.GetDisplaySize();
+
+		const float Parameters[] = { Origin.X, Origin.Y, Scale.X, Scale.Y, Tint.R, Tint.G, Tint.B, Tint.A,
+			ClippingRect.Left, ClippingRect.Top, ClippingRect.Right, ClippingRect.Bottom, DisplaySize.X, DisplaySize.Y };
+
+		return CityHash64WithSeed(reinterpret_cast<const char*>(Parameters), sizeof(Parameters), Frame.GetContentHash());
+	}
+#endif // IMGUI_DIRECT_RENDERER
 }
 
 int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect,
@@ -516,53 +595,190 @@ int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeo
 
 		FImGuiModuleManager* ImGuiModuleManager = ImGuiModule.GetImGuiModuleManager();
 
+		const FLinearColor Tint = WidgetStyle.GetColorAndOpacityTint();
+
 #if WITH_OBSOLETE_CLIPPING_API
 		// Convert clipping rectangle to format required by Slate vertex.
 		const FSlateRotatedRect VertexClippingRect{ MyClippingRect };
 #endif // WITH_OBSOLETE_CLIPPING_API
 
-		for (const auto& DrawList : ContextProxy->GetDrawData())
+		// Take the latest frame published by the context. It is immutable, so it can be painted while context is updated.
+		const FImGuiFrameSnapshotRef Frame = ContextProxy->GetFrame();
+
+		// Direct renderer passes the whole frame to the render thread without converting it to Slate vertices. Cached
+		// output is drawn by the same renderer.
+		const bool bCachedOutput = (CVars::CachedOutput.GetValueOnGameThread() > 0);
+		const bool bDirectRenderer = bCachedOutput || (CVars::DirectRenderer.GetValueOnGameThread() > 0);
+
+#if IMGUI_DIRECT_RENDERER
+		if (bDirectRenderer && FImGuiSlateDrawer::IsSupported())
 		{
+			if (!SlateDrawer.IsValid())
+			{
+				SlateDrawer = MakeShared<FImGuiSlateDrawer, ESPMode::ThreadSafe>();
+			}
+
+			const FTextureManager& TextureManager = ImGuiModuleManager->GetTextureManager();
+
+			TArray<FTexture*> Textures;
+			Textures.Reserve(TextureManager.NumTextures());
+			for (TextureIndex Index = 0; Index < TextureManager.NumTextures(); Index++)
+			{
+				Textures.Add(TextureManager.GetTextureResource(Index));
+			}
+
+			FImGuiSlateDrawer::ECacheMode CacheMode = FImGuiSlateDrawer::ECacheMode::None;
+			if (bCachedOutput)
+			{
+				// Redraw cache only if output would change or if it is too old.
+				const uint64 Fingerprint = GetOutputFingerprint(*Frame, Transform, Tint, MyClippingRect);
+				const float MaxStaleness = CVars::CachedOutputMaxStaleness.GetValueOnGameThread();
+				const double Time = FPlatformTime::Seconds();
+
+				const bool bRedraw = !bHasCachedOutput || Fingerprint != CachedOutputFingerprint
+					|| (MaxStaleness > 0.f && Time - CachedOutputTime >= MaxStaleness);
+
+				if (bRedraw)
+				{
+					CachedOutputFingerprint = Fingerprint;
+					CachedOutputTime = Time;
+					CachedOutputRedraws++;
+				}
+				else
+				{
+					CachedOutputReuses++;
+				}
+
+				bHasCachedOutput = true;
+				CacheMode = bRedraw ? FImGuiSlateDrawer::ECacheMode::Redraw : FImGuiSlateDrawer::ECacheMode::Reuse;
+				LastFrameBatchesSource = bRedraw ? TEXT("Cached (Redrawn)") : TEXT("Cached");
+			}
+			else
+			{
+				bHasCachedOutput = false;
+				LastFrameBatchesSource = TEXT("Direct");
+			}
+
+			SlateDrawer->SetFrame(Frame, Transform, Tint, MyClippingRect, MoveTemp(Textures), CacheMode);
+			FSlateDrawElement::MakeCustom(OutDrawElements, LayerId, SlateDrawer);
+
+			int32 NumDrawCommands = 0;
+			for (const auto& DrawList : Frame->GetDrawLists())
+			{
+				NumDrawCommands += DrawList.NumCommands();
+			}
+
+			LastFrameDrawCommands = NumDrawCommands;
+			LastFrameSlateElements = 1;
+			LastFrameCulledDrawCommands = 0;
+			LastFrameCulledDrawLists = 0;
+			LastFrameOccludedDrawLists = Frame->NumOccludedDrawLists();
+			LastFrameVertexCacheHits = 0;
+			LastFrameVertexCacheMisses = 0;
+
+			return LayerId;
+		}
+#endif // IMGUI_DIRECT_RENDERER
+
+		if (bDirectRenderer)
+		{
+			WarnDirectRendererFallback();
+		}
+
+		bHasCachedOutput = false;
+
+		// Frames are converted once and shared by all widgets using the same context. If this widget has a different
+		// transform or tint, then it either translates shared batches or converts its own.
 #if WITH_OBSOLETE_CLIPPING_API
-			DrawList.CopyVertexData(VertexBuffer, Transform, WidgetStyle, VertexClippingRect);
+		const FImGuiDrawBatcher& SharedBatches = ContextProxy->GetDrawBatches(*Frame, Transform, Tint, VertexClippingRect);
+		const bool bUseSharedBatches = SharedBatches.IsConvertedWith(Transform, Tint, VertexClippingRect);
+#else
+		const FImGuiDrawBatcher& SharedBatches = ContextProxy->GetDrawBatches(*Frame, Transform, Tint);
+		const bool bUseSharedBatches = SharedBatches.IsConvertedWith(Transform, Tint);
+#endif // WITH_OBSOLETE_CLIPPING_API
 
-			// Get access to the Slate scissor rectangle defined in Slate Core API, so we can customize elements drawing.
-			extern SLATECORE_API TOptional<FShortRect> GSlateScissorRect;
-			auto GSlateScissorRectSaver = ScopeGuards::MakeStateSaver(GSlateScissorRect);
+		FVector2D Offset;
+		if (bUseSharedBatches)
+		{
+			LastFrameBatchesSource = TEXT("Shared");
+		}
+		else if (SharedBatches.GetTranslationTo(Transform, Tint, Offset))
+		{
+#if WITH_OBSOLETE_CLIPPING_API
+			DrawBatcher.CopyTranslated(SharedBatches, Offset, VertexClippingRect);
 #else
-			DrawList.CopyVertexData(VertexBuffer, Transform, WidgetStyle);
+			DrawBatcher.CopyTranslated(SharedBatches, Offset);
+#endif // WITH_OBSOLETE_CLIPPING_API
+			LastFrameBatchesSource = TEXT("Translated");
+		}
+		else
+		{
+#if WITH_OBSOLETE_CLIPPING_API
+			DrawBatcher.Reset(Transform, Tint, MyClippingRect, VertexClippingRect);
+#else
+			DrawBatcher.Reset(Transform, Tint, MyClippingRect);
 #endif // WITH_OBSOLETE_CLIPPING_API
 
-			int IndexBufferOffset = 0;
-			for (int CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
+			// Convert draw lists to batches, merging compatible draw commands into shared Slate elements.
+			for (const auto& DrawList : Frame->GetDrawLists())
 			{
-				const auto& DrawCommand = DrawList.GetCommand(CommandNb, Transform);
+				DrawBatcher.AddDrawList(DrawList);
+			}
 
-				DrawList.CopyIndexData(IndexBuffer, IndexBufferOffset, DrawCommand.NumElements);
+			// Convert vertex and index data of all batches (optionally in parallel).
+			DrawBatcher.Convert();
 
-				// Advance offset by number of copied elements to position it for the next command.
-				IndexBufferOffset += DrawCommand.NumElements;
+			LastFrameBatchesSource = TEXT("Converted");
+		}
 
-				// Get texture resource handle for this draw command (null index will be also mapped to a valid texture).
-				const FSlateResourceHandle& Handle = ImGuiModuleManager->GetTextureManager().GetTextureHandle(DrawCommand.TextureId);
+		const FImGuiDrawBatcher& Batches = bUseSharedBatches ? SharedBatches : DrawBatcher;
+
+#if WITH_OBSOLETE_CLIPPING_API
+		// Get access to the Slate scissor rectangle defined in Slate Core API, so we can customize elements drawing.
+		extern SLATECORE_API TOptional<FShortRect> GSlateScissorRect;
+		auto GSlateScissorRectSaver = ScopeGuards::MakeStateSaver(GSlateScissorRect);
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+		int32 SubmittedBatches = 0;
+		int32 CulledBatchCommands = 0;
+		for (int32 BatchNb = 0; BatchNb < Batches.NumBatches(); BatchNb++)
+		{
+			const FImGuiDrawBatch& Batch = Batches.GetBatch(BatchNb);
+
+			// Shared batches are only clipped to the canvas, so they still need to be clipped to this widget.
+			bool bOverlapping;
+			const FSlateRect ClippingRect = Batch.ClippingRect.IntersectionWith(MyClippingRect, bOverlapping);
+			if (!bOverlapping)
+			{
+				CulledBatchCommands += Batch.NumCommands;
+				continue;
+			}
 
-				// Transform clipping rectangle to screen space and apply to elements that we draw.
-				const FSlateRect ClippingRect = DrawCommand.ClippingRect.IntersectionWith(MyClippingRect);
+			// Get texture resource handle for this batch (null index will be also mapped to a valid texture).
+			const FSlateResourceHandle& Handle = ImGuiModuleManager->GetTextureManager().GetTextureHandle(Batch.TextureId);
 
 #if WITH_OBSOLETE_CLIPPING_API
-				GSlateScissorRect = FShortRect{ ClippingRect };
+			GSlateScissorRect = FShortRect{ ClippingRect };
 #else
-				OutDrawElements.PushClip(FSlateClippingZone{ ClippingRect });
+			OutDrawElements.PushClip(FSlateClippingZone{ ClippingRect });
 #endif // WITH_OBSOLETE_CLIPPING_API
 
-				// Add elements to the list.
-				FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Handle, VertexBuffer, IndexBuffer, nullptr, 0, 0);
+			// Add elements to the list.
+			FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, Handle, *Batch.VertexBuffer, *Batch.IndexBuffer, nullptr, 0, 0);
+			SubmittedBatches++;
 
 #if !WITH_OBSOLETE_CLIPPING_API
-				OutDrawElements.PopClip();
+			OutDrawElements.PopClip();
 #endif // WITH_OBSOLETE_CLIPPING_API
-			}
 		}
+
+		LastFrameDrawCommands = Batches.NumCommands();
+		LastFrameSlateElements = SubmittedBatches;
+		LastFrameCulledDrawCommands = Batches.NumCulledCommands() + CulledBatchCommands;
+		LastFrameCulledDrawLists = Batches.NumCulledDrawLists();
+		LastFrameOccludedDrawLists = Batches.NumOccludedDrawLists();
+		LastFrameVertexCacheHits = Batches.NumVertexCacheHits();
+		LastFrameVertexCacheMisses = Batches.NumVertexCacheMisses();
 	}
 
 	return LayerId;
@@ -573,6 +789,15 @@ FVector2D SImGuiWidget::ComputeDesiredSize(float) const
 	return FVector2D{ 3840.f, 2160.f };
 }
 
+void SImGuiWidget::OnFrameChanged()
+{
+	// This widget is not volatile, so parents like invalidation panels can cache its paint for as long as the context
+	// publishes frames that look the same. Geometry changes are handled by Slate layout. Layout is the narrowest reason
+	// supported by this engine version and it doesn't change volatility.
+	Invalidate(EInvalidateWidget::Layout);
+	PaintInvalidations++;
+}
+
 static TArray<FKey> GetImGuiMappedKeys()
 {
 	TArray<FKey> Keys;
@@ -612,8 +837,86 @@ static TArray<FKey> GetImGuiMappedKeys()
 	return Keys;
 }
 
+namespace
+{
+	void DrawLargeDrawListWindow()
+	{
+		// With 16-bit indices, ImGui can only address 64K vertices in a single draw list.
+		constexpr int32 NumColumns = 300;
+		constexpr int32 NumRows = (sizeof(ImDrawIdx) > sizeof(uint16)) ? 100 : 40;
+		constexpr float CellSize = 2.f;
+
+		bool bOpen = true;
+		ImGui::SetNextWindowSize(ImVec2(NumColumns * CellSize + 40.f, NumRows * CellSize + 80.f), ImGuiSetCond_Once);
+		if (ImGui::Begin("ImGui Large Draw List", &bOpen))
+		{
+			ImDrawList* DrawList = ImGui::GetWindowDrawList();
+			const int32 FirstVertex = DrawList->VtxBuffer.Size;
+
+			// Every rectangle is a quad with 4 vertices.
+			const ImVec2 Origin = ImGui::GetCursorScreenPos();
+			for (int32 Row = 0; Row < NumRows; Row++)
+			{
+				for (int32 Column = 0; Column < NumColumns; Column++)
+				{
+					const ImVec2 Min{ Origin.x + Column * CellSize, Origin.y + Row * CellSize };
+					const ImU32 Color = IM_COL32(Column * 255 / NumColumns, Row * 255 / NumRows, 128, 255);
+					DrawList->AddRectFilled(Min, ImVec2{ Min.x + CellSize, Min.y + CellSize }, Color);
+				}
+			}
+
+			const int32 NumVertices = DrawList->VtxBuffer.Size - FirstVertex;
+
+			ImGui::Dummy(ImVec2(NumColumns * CellSize, NumRows * CellSize));
+			ImGui::Text("Vertices: %d (Index Size: %d bytes)", NumVertices, static_cast<int32>(sizeof(ImDrawIdx)));
+		}
+		ImGui::End();
+
+		if (!bOpen)
+		{
+			CVars::DebugLargeDrawList->Set(0, ECVF_SetByConsole);
+		}
+	}
+
+	void DrawOcclusionOverlay(const FImGuiFrameSnapshot& Frame)
+	{
+		const ImU32 OccluderColor = IM_COL32(64, 255, 64, 255);
+		const ImU32 OccludedColor = IM_COL32(255, 64, 64, 255);
+
+		ImDrawList* OverlayDrawList = ImGui::GetOverlayDrawList();
+
+		for (const FSlateRect& Rect : Frame.GetOccluderRects())
+		{
+			OverlayDrawList->AddRect(ImVec2{ Rect.Left, Rect.Top }, ImVec2{ Rect.Right, Rect.Bottom }, OccluderColor, 0.f, ~0, 2.f);
+		}
+
+		for (const auto& DrawList : Frame.GetDrawLists())
+		{
+			if (DrawList.IsOccluded())
+			{
+				const FSlateRect Bounds = DrawList.GetClippingBounds(FTransform2D{});
+				OverlayDrawList->AddRect(ImVec2{ Bounds.Left, Bounds.Top }, ImVec2{ Bounds.Right, Bounds.Bottom }, OccludedColor);
+				OverlayDrawList->AddText(ImVec2{ Bounds.Left + 4.f, Bounds.Top + 2.f }, OccludedColor, "Occluded");
+			}
+		}
+	}
+}
+
 void SImGuiWidget::OnDebugDraw()
 {
+	if (CVars::DebugLargeDrawList.GetValueOnGameThread() > 0)
+	{
+		DrawLargeDrawListWindow();
+	}
+
+	if (CVars::DebugOcclusionCulling.GetValueOnGameThread() > 0)
+	{
+		if (FImGuiContextProxy* ContextProxy = GetContextProxy())
+		{
+			DrawOcclusionOverlay(*ContextProxy->GetFrame());
+		}
+	}
+
 	if (CVars::DebugWidget.GetValueOnGameThread() > 0)
 	{
 		bool bDebug = true;
@@ -650,6 +953,23 @@ void SImGuiWidget::OnDebugDraw()
 				FImGuiContextProxy* ContextProxy = GetContextProxy();
 				TwoColumns::Value("Display Size", ContextProxy ? *ContextProxy->GetDisplaySize().ToString() : TEXT("< Null >"));
 			});
+
+			TwoColumns::CollapsingGroup("Rendering", [&]()
+			{
+				TwoColumns::Value("Batches", LastFrameBatchesSource);
+				TwoColumns::Value("Paint Invalidations", PaintInvalidations);
+				TwoColumns::Value("Draw Commands", LastFrameDrawCommands);
+				TwoColumns::Value("Slate Elements", LastFrameSlateElements);
+				TwoColumns::Value("Culled Draw Commands", LastFrameCulledDrawCommands);
+				TwoColumns::Value("Culled Draw Lists", LastFrameCulledDrawLists);
+				TwoColumns::Value("Occluded Draw Lists", LastFrameOccludedDrawLists);
+				TwoColumns::Value("Vertex Cache Hits", LastFrameVertexCacheHits);
+				TwoColumns::Value("Vertex Cache Misses", LastFrameVertexCacheMisses);
+				TwoColumns::Value("Cached Output Redraws", CachedOutputRedraws);
+				TwoColumns::Value("Cached Output Reuses", CachedOutputReuses);
+				TwoColumns::Value("Cached Output Redraw Ratio", (CachedOutputRedraws + CachedOutputReuses > 0)
+					? static_cast<float>(CachedOutputRedraws) / (CachedOutputRedraws + CachedOutputReuses) : 0.f);
+			});
 		}
 		ImGui::End();
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ImGuiDrawBatcher.h"
 #include "ImGuiInputState.h"
 
 #include <Widgets/SLeafWidget.h>
@@ -9,6 +10,7 @@
 
 class FImGuiModuleManager;
 class FImGuiContextProxy;
+class FImGuiSlateDrawer;
 class UImGuiInputHandler;
 
 // Slate widget for rendering ImGui output and storing Slate inputs.
@@ -89,12 +91,37 @@ private:
 
 	virtual FVector2D ComputeDesiredSize(float) const override;
 
+	// Invalidate paint after the context published a frame that looks different.
+	void OnFrameChanged();
+
 	void OnDebugDraw();
 
 	TWeakObjectPtr<UImGuiInputHandler> InputHandler;
 
-	mutable TArray<FSlateVertex> VertexBuffer;
-	mutable TArray<SlateIndex> IndexBuffer;
+	// Batches used when this widget cannot directly use batches shared by its context (see FImGuiContextProxy::GetDrawBatches).
+	mutable FImGuiDrawBatcher DrawBatcher;
+
+	// Custom Slate element used by the direct renderer (see ImGui.Render.DirectRenderer). Slate only keeps a weak
+	// reference, so it is owned by this widget.
+	mutable TSharedPtr<FImGuiSlateDrawer, ESPMode::ThreadSafe> SlateDrawer;
+
+	// Rendering statistics from the last frame (for debugging).
+	mutable int32 LastFrameDrawCommands = 0;
+	mutable int32 LastFrameSlateElements = 0;
+	mutable int32 LastFrameCulledDrawCommands = 0;
+	mutable int32 LastFrameCulledDrawLists = 0;
+	mutable int32 LastFrameOccludedDrawLists = 0;
+	mutable int32 LastFrameVertexCacheHits = 0;
+	mutable int32 LastFrameVertexCacheMisses = 0;
+	mutable const TCHAR* LastFrameBatchesSource = TEXT("None");
+	uint32 PaintInvalidations = 0;
+
+	// State of the cached output (see ImGui.Render.CachedOutput). Fingerprint and time are from the last redraw.
+	mutable uint64 CachedOutputFingerprint = 0;
+	mutable double CachedOutputTime = 0.0;
+	mutable uint32 CachedOutputRedraws = 0;
+	mutable uint32 CachedOutputReuses = 0;
+	mutable bool bHasCachedOutput = false;
 
 	FImGuiContextProxy * ContextProxy;
 
@@ -0,0 +1,109 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiContextManager.h"
+#include "ImGuiContextScope.h"
+#include "Tests/ImGuiTestUtilities.h"
+
+#include <Engine/World.h>
+#include <Misc/AutomationTest.h>
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using ImGuiTests::FConsoleVariableScope;
+
+namespace
+{
+	// Number of text lines drawn to every context in every frame.
+	constexpr int32 NumLines = 256;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiParallelTickPerfTest, "ImGui.ContextManager.ParallelTickPerf",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FImGuiParallelTickPerfTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 MaxContexts = 8;
+	constexpr int32 NumWarmUpTicks = 8;
+	constexpr int32 NumTimedTicks = 64;
+	constexpr float DeltaSeconds = 1.f / 60.f;
+
+#if IMGUI_THREAD_LOCAL_CONTEXT
+	constexpr int32 MaxParallelTick = 1;
+#else
+	constexpr int32 MaxParallelTick = 0;
+	AddWarning(TEXT("ImGui is built without thread-local contexts, so only serial ticks are measured (see bThreadLocalContext in ImGui.Build.cs)."));
+#endif // IMGUI_THREAD_LOCAL_CONTEXT
+
+	// Every tick updates all contexts and frames are rendered during the tick, so they can be timed together.
+	const FConsoleVariableScope UpdateRate{ TEXT("ImGui.UpdateRate"), 0 };
+	const FConsoleVariableScope PipelinedRender{ TEXT("ImGui.PipelinedRender"), 0 };
+
+	// Contexts of this manager become current during ticks, so the current context is restored after it is destroyed.
+	const FImGuiContextScope ContextScope{ ImGui::GetCurrentContext() };
+
+	// In editor, contexts for null and editor worlds are mapped to the editor context, so a game world is needed to get
+	// separate contexts. It is only used to select the context type.
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	{
+		FImGuiContextManager ContextManager;
+
+		for (int32 NumContexts = 1; NumContexts <= MaxContexts; NumContexts++)
+		{
+			FImGuiContextProxy* ContextProxy = ContextManager.GetWorldContextProxy(World, *FString::Printf(TEXT("ParallelTickPerf%d"), NumContexts));
+
+			// Test contexts should not save their state.
+			ContextProxy->SetAsCurrent();
+			ImGui::GetIO().IniFilename = nullptr;
+
+			// Only context's own thread-safe draw events are called concurrently, shared ones are serialised.
+			ContextProxy->OnThreadSafeDraw().AddLambda([]()
+			{
+				ImGui::Begin("Parallel Tick Perf");
+				for (int32 Line = 0; Line < NumLines; Line++)
+				{
+					ImGui::Text("Line %d: %.3f", Line, Line * 0.5f);
+				}
+				ImGui::End();
+			});
+
+			double Milliseconds[2] = { 0.0, 0.0 };
+			for (int32 ParallelTick = 0; ParallelTick <= MaxParallelTick; ParallelTick++)
+			{
+				const FConsoleVariableScope Parallel{ TEXT("ImGui.ParallelTick"), ParallelTick };
+
+				// Contexts are ticked once per engine frame, so every tick needs a new frame number.
+				for (int32 Tick = 0; Tick < NumWarmUpTicks; Tick++)
+				{
+					GFrameNumber++;
+					ContextManager.Tick(DeltaSeconds);
+				}
+
+				const double StartTime = FPlatformTime::Seconds();
+				for (int32 Tick = 0; Tick < NumTimedTicks; Tick++)
+				{
+					GFrameNumber++;
+					ContextManager.Tick(DeltaSeconds);
+				}
+				Milliseconds[ParallelTick] = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumTimedTicks;
+			}
+
+			if (MaxParallelTick > 0)
+			{
+				AddInfo(FString::Printf(TEXT("%d contexts: %.3f ms per tick with ImGui.ParallelTick 0, %.3f ms with 1 (%.2fx)."),
+					NumContexts, Milliseconds[0], Milliseconds[1], Milliseconds[0] / FMath::Max(Milliseconds[1], SMALL_NUMBER)));
+			}
+			else
+			{
+				AddInfo(FString::Printf(TEXT("%d contexts: %.3f ms per tick with ImGui.ParallelTick 0."), NumContexts, Milliseconds[0]));
+			}
+		}
+	}
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
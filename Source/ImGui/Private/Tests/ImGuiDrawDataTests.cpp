@@ -0,0 +1,534 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiContextScope.h"
+#include "ImGuiDrawBatcher.h"
+#include "ImGuiDrawData.h"
+#include "Tests/ImGuiTestUtilities.h"
+
+#include <Misc/AutomationTest.h>
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+using ImGuiTests::FConsoleVariableScope;
+
+namespace
+{
+	// Vectorized conversion uses a different order of operations, so positions are compared with a tolerance. Texture
+	// coordinates are copied, but clipping interpolates them.
+	constexpr float PositionTolerance = 0.01f;
+	constexpr float TexCoordsTolerance = 0.0001f;
+
+	// Move vertices and indices to a draw list, with indices split between draw commands.
+	void MakeDrawList(FImGuiDrawList& OutDrawList, const TArray<ImDrawVert>& Vertices, const TArray<ImDrawIdx>& Indices,
+		int32 MaxElementsPerCommand = MAX_int32)
+	{
+		ImDrawList Source{ nullptr };
+
+		Source.VtxBuffer.resize(Vertices.Num());
+		FMemory::Memcpy(Source.VtxBuffer.Data, Vertices.GetData(), Vertices.Num() * sizeof(ImDrawVert));
+
+		Source.IdxBuffer.resize(Indices.Num());
+		FMemory::Memcpy(Source.IdxBuffer.Data, Indices.GetData(), Indices.Num() * sizeof(ImDrawIdx));
+
+		for (int32 StartIndex = 0; StartIndex < Indices.Num(); StartIndex += MaxElementsPerCommand)
+		{
+			ImDrawCmd Command;
+			Command.ElemCount = static_cast<unsigned int>(FMath::Min(Indices.Num() - StartIndex, MaxElementsPerCommand));
+			Command.ClipRect = { 0.f, 0.f, 3840.f, 2160.f };
+			Source.CmdBuffer.push_back(Command);
+		}
+
+		OutDrawList.TransferDrawData(Source);
+	}
+
+	FVector2D GetPosition(const FSlateVertex& SlateVertex)
+	{
+		return FVector2D{ SlateVertex.Position[0], SlateVertex.Position[1] };
+	}
+
+	// Expected color computed with full conversion, without using the lookup table.
+	FColor GetExpectedColor(ImU32 Color, const FLinearColor& Tint)
+	{
+		return (Tint * FLinearColor{ ImGuiInterops::UnpackImU32Color(Color) }).ToFColor(true);
+	}
+
+	// Compare a single converted vertex with the expected values.
+	// @returns True, if vertex matches
+	bool TestVertex(FAutomationTestBase& Test, const FString& What, const FSlateVertex& Actual, const FVector2D& Position, float U, float V,
+		const FColor& Color)
+	{
+		const bool bPositionEqual = GetPosition(Actual).Equals(Position, PositionTolerance);
+		const bool bTexCoordsEqual = FMath::IsNearlyEqual(Actual.TexCoords[0], U, TexCoordsTolerance)
+			&& FMath::IsNearlyEqual(Actual.TexCoords[1], V, TexCoordsTolerance) && Actual.TexCoords[2] == 1.f && Actual.TexCoords[3] == 1.f;
+		const bool bColorEqual = Actual.Color == Color;
+
+		if (!bPositionEqual || !bTexCoordsEqual || !bColorEqual)
+		{
+			Test.AddError(FString::Printf(TEXT("%s: Position = %s (expected %s), TexCoords = (%f, %f, %f, %f) (expected (%f, %f, 1, 1)), Color = %s (expected %s)."),
+				*What, *GetPosition(Actual).ToString(), *Position.ToString(), Actual.TexCoords[0], Actual.TexCoords[1], Actual.TexCoords[2],
+				Actual.TexCoords[3], U, V, *Actual.Color.ToString(), *Color.ToString()));
+			return false;
+		}
+
+		return true;
+	}
+
+	// Convert all vertices of the draw list and compare them with vertices converted one by one in this test.
+	void TestConversion(FAutomationTestBase& Test, const FString& What, const FImGuiDrawList& DrawList, const TArray<ImDrawVert>& Source,
+		const FTransform2D& Transform, const FLinearColor& Tint)
+	{
+		const FImGuiColorTable ColorTable{ Tint };
+
+		TArray<FSlateVertex> Converted;
+		Converted.SetNumZeroed(DrawList.NumVertices());
+
+#if WITH_OBSOLETE_CLIPPING_API
+		DrawList.CopyVertexData(Converted.GetData(), Transform, ColorTable, FSlateRotatedRect{}, DrawList.GetVertexRange());
+#else
+		DrawList.CopyVertexData(Converted.GetData(), Transform, ColorTable, DrawList.GetVertexRange());
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+		for (int32 Idx = 0; Idx < Source.Num(); Idx++)
+		{
+			const ImDrawVert& Vertex = Source[Idx];
+			const FVector2D Position = Transform.TransformPoint(FVector2D{ Vertex.pos.x, Vertex.pos.y });
+
+			if (!TestVertex(Test, FString::Printf(TEXT("%s, vertex %d"), *What, Idx), Converted[Idx], Position, Vertex.uv.x, Vertex.uv.y,
+				GetExpectedColor(Vertex.col, Tint)))
+			{
+				return;
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiVertexConversionTest, "ImGui.DrawData.VertexConversion",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiVertexConversionTest::RunTest(const FString& Parameters)
+{
+	// Number of vertices is not a multiple of four, so vectorized variants also convert the remainder one by one.
+	TArray<ImDrawVert> Vertices;
+	TArray<ImDrawIdx> Indices;
+	const ImU32 Colors[] = { IM_COL32(255, 255, 255, 255), IM_COL32(255, 0, 0, 255), IM_COL32(12, 34, 56, 78), IM_COL32(0, 128, 255, 0) };
+	for (int32 Idx = 0; Idx < 11; Idx++)
+	{
+		Vertices.Add({ { 10.f * Idx - 3.5f, 0.25f * Idx * Idx }, { Idx / 11.f, 1.f - Idx / 22.f }, Colors[Idx % 4] });
+		Indices.Add(static_cast<ImDrawIdx>(Idx));
+	}
+	Indices.Add(0);
+
+	FImGuiDrawList DrawList;
+	MakeDrawList(DrawList, Vertices, Indices);
+	TestEqual(TEXT("Number of vertices"), DrawList.NumVertices(), Vertices.Num());
+
+	const FTransform2D Transforms[] =
+	{
+		FTransform2D{},
+		FTransform2D{ FVector2D{ 10.5f, -20.25f } },
+		FTransform2D{ FMatrix2x2{ 1.5f, 0.4f, -0.3f, 0.75f }, FVector2D{ 100.f, 50.f } }
+	};
+
+	const FLinearColor Tints[] = { FLinearColor::White, FLinearColor{ 0.5f, 0.75f, 1.f, 0.25f } };
+
+	// Reference, general vectorized and specialized vectorized conversions should give the same results.
+	const int32 Modes[][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 } };
+	for (const auto& Mode : Modes)
+	{
+		const FConsoleVariableScope Vectorized{ TEXT("ImGui.Render.VectorizedVertexConversion"), Mode[0] };
+		const FConsoleVariableScope Specialized{ TEXT("ImGui.Render.SpecializedVertexConversion"), Mode[1] };
+
+		int32 TransformNb = 0;
+		for (const FTransform2D& Transform : Transforms)
+		{
+			for (const FLinearColor& Tint : Tints)
+			{
+				TestConversion(*this, FString::Printf(TEXT("Vectorized = %d, Specialized = %d, Transform %d, Tint = %s"), Mode[0], Mode[1],
+					TransformNb, *Tint.ToString()), DrawList, Vertices, Transform, Tint);
+			}
+			TransformNb++;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiVertexConversionPerfTest, "ImGui.DrawData.VertexConversionPerf",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FImGuiVertexConversionPerfTest::RunTest(const FString& Parameters)
+{
+	// Large draw list, so timings are dominated by conversion rather than by dispatch.
+	constexpr int32 NumVertices = 256 * 1024;
+	constexpr int32 NumRuns = 20;
+
+	TArray<ImDrawVert> Vertices;
+	TArray<ImDrawIdx> Indices;
+	Vertices.Reserve(NumVertices);
+	for (int32 Idx = 0; Idx < NumVertices; Idx++)
+	{
+		Vertices.Add({ { static_cast<float>(Idx % 1920), static_cast<float>(Idx / 1920) }, { (Idx % 256) / 256.f, (Idx % 64) / 64.f },
+			IM_COL32(Idx % 256, (Idx / 256) % 256, 255 - Idx % 256, 128 + Idx % 128) });
+	}
+	Indices.Add(0);
+
+	FImGuiDrawList DrawList;
+	MakeDrawList(DrawList, Vertices, Indices);
+
+	TArray<FSlateVertex> Converted;
+	Converted.SetNumZeroed(NumVertices);
+
+	struct FKernel
+	{
+		const TCHAR* Name;
+		int32 Vectorized;
+		int32 Specialized;
+		bool bTranslationOnly;
+	};
+
+	// Kernels are selected by console variables and transform, in the same way as in rendering.
+	const FKernel Kernels[] =
+	{
+		{ TEXT("Reference"), 0, 0, true },
+		{ TEXT("Vectorized, not specialized"), 1, 0, true },
+		{ TEXT("General"), 1, 1, false },
+		{ TEXT("Translation"), 1, 1, true }
+	};
+
+	const FTransform2D TranslationTransform{ FVector2D{ 10.f, 20.f } };
+	const FTransform2D GeneralTransform{ FMatrix2x2{ 1.25f, 0.f, 0.f, 1.25f }, FVector2D{ 10.f, 20.f } };
+
+	const FLinearColor Tints[] = { FLinearColor::White, FLinearColor{ 0.5f, 0.75f, 1.f, 0.8f } };
+	for (const FLinearColor& Tint : Tints)
+	{
+		const FImGuiColorTable ColorTable{ Tint };
+		double ReferenceSeconds = 0.0;
+
+		for (const FKernel& Kernel : Kernels)
+		{
+			const FConsoleVariableScope Vectorized{ TEXT("ImGui.Render.VectorizedVertexConversion"), Kernel.Vectorized };
+			const FConsoleVariableScope Specialized{ TEXT("ImGui.Render.SpecializedVertexConversion"), Kernel.Specialized };
+			const FTransform2D& Transform = Kernel.bTranslationOnly ? TranslationTransform : GeneralTransform;
+
+			// The best of several runs is reported, as it is the least affected by other work on the machine.
+			double BestSeconds = DBL_MAX;
+			for (int32 Run = 0; Run < NumRuns; Run++)
+			{
+				const double StartSeconds = FPlatformTime::Seconds();
+#if WITH_OBSOLETE_CLIPPING_API
+				DrawList.CopyVertexData(Converted.GetData(), Transform, ColorTable, FSlateRotatedRect{}, DrawList.GetVertexRange());
+#else
+				DrawList.CopyVertexData(Converted.GetData(), Transform, ColorTable, DrawList.GetVertexRange());
+#endif // WITH_OBSOLETE_CLIPPING_API
+				BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartSeconds);
+			}
+
+			if (Kernel.Vectorized == 0)
+			{
+				ReferenceSeconds = BestSeconds;
+			}
+
+			AddInfo(FString::Printf(TEXT("%s, %s tint: %.3f ms for %d vertices (%.2fx reference)."), Kernel.Name,
+				ColorTable.IsIdentity() ? TEXT("identity") : TEXT("custom"), BestSeconds * 1000.0, NumVertices,
+				(BestSeconds > 0.0) ? ReferenceSeconds / BestSeconds : 0.0));
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiQuadClippingTest, "ImGui.DrawData.QuadClipping",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiQuadClippingTest::RunTest(const FString& Parameters)
+{
+	// Two quads in the layout generated by ImGui. The first one is partially clipped and the second one is outside.
+	const ImU32 Color = IM_COL32(200, 100, 50, 255);
+	const TArray<ImDrawVert> Vertices =
+	{
+		{ { 0.f, 0.f }, { 0.f, 0.f }, Color }, { { 10.f, 0.f }, { 1.f, 0.f }, Color },
+		{ { 10.f, 10.f }, { 1.f, 1.f }, Color }, { { 0.f, 10.f }, { 0.f, 1.f }, Color },
+		{ { 30.f, 0.f }, { 0.f, 0.f }, Color }, { { 40.f, 0.f }, { 1.f, 0.f }, Color },
+		{ { 40.f, 10.f }, { 1.f, 1.f }, Color }, { { 30.f, 10.f }, { 0.f, 1.f }, Color }
+	};
+	const TArray<ImDrawIdx> Indices = { 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7 };
+
+	FImGuiDrawList DrawList;
+	MakeDrawList(DrawList, Vertices, Indices);
+	TestTrue(TEXT("Quads are recognised as axis-aligned"), DrawList.IsAxisAlignedQuads(0, Indices.Num()));
+
+	// In screen space, the first quad is at (5, 5) - (15, 15) and the second one at (35, 5) - (45, 15).
+	const FTransform2D Transform{ FVector2D{ 5.f, 5.f } };
+	const FSlateRect ClippingRect{ 10.f, 5.f, 20.f, 12.f };
+	const FLinearColor Tint{ 1.f, 0.5f, 0.5f, 1.f };
+	const FImGuiColorTable ColorTable{ Tint };
+
+	TArray<FSlateVertex> VertexBuffer;
+	TArray<SlateIndex> IndexBuffer;
+
+#if WITH_OBSOLETE_CLIPPING_API
+	const int32 NumQuads = DrawList.AppendClippedQuads(VertexBuffer, IndexBuffer, Transform, ColorTable, FSlateRotatedRect{}, 0, Indices.Num(), ClippingRect);
+#else
+	const int32 NumQuads = DrawList.AppendClippedQuads(VertexBuffer, IndexBuffer, Transform, ColorTable, 0, Indices.Num(), ClippingRect);
+#endif // WITH_OBSOLETE_CLIPPING_API
+
+	TestEqual(TEXT("Number of appended quads"), NumQuads, 1);
+	TestEqual(TEXT("Number of vertices"), VertexBuffer.Num(), 4);
+	TestEqual(TEXT("Number of indices"), IndexBuffer.Num(), 6);
+	if (VertexBuffer.Num() != 4 || IndexBuffer.Num() != 6)
+	{
+		return false;
+	}
+
+	// Positions are trimmed to the clipping rectangle and texture coordinates are trimmed proportionally.
+	const FColor ExpectedColor = GetExpectedColor(Color, Tint);
+	TestVertex(*this, TEXT("Clipped vertex 0"), VertexBuffer[0], { 10.f, 5.f }, 0.5f, 0.f, ExpectedColor);
+	TestVertex(*this, TEXT("Clipped vertex 1"), VertexBuffer[1], { 15.f, 5.f }, 1.f, 0.f, ExpectedColor);
+	TestVertex(*this, TEXT("Clipped vertex 2"), VertexBuffer[2], { 15.f, 12.f }, 1.f, 0.7f, ExpectedColor);
+	TestVertex(*this, TEXT("Clipped vertex 3"), VertexBuffer[3], { 10.f, 12.f }, 0.5f, 0.7f, ExpectedColor);
+
+	const int32 ExpectedIndices[] = { 0, 1, 2, 0, 2, 3 };
+	for (int32 Idx = 0; Idx < 6; Idx++)
+	{
+		TestEqual(FString::Printf(TEXT("Clipped index %d"), Idx), static_cast<int32>(IndexBuffer[Idx]), ExpectedIndices[Idx]);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiGlyphInstancesTest, "ImGui.DrawData.GlyphInstances",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiGlyphInstancesTest::RunTest(const FString& Parameters)
+{
+	// Text rendered by a temporary context with its own font atlas. Only CPU data are used, so this works without RHI.
+	ImFontAtlas FontAtlas;
+	unsigned char* Pixels;
+	int Width, Height, Bpp;
+	FontAtlas.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+
+	FImGuiDrawList DrawList;
+	{
+		ImGuiContext* Context = ImGui::CreateContext(&FontAtlas);
+		const FImGuiContextScope ContextScope{ Context };
+
+		ImGuiIO& IO = ImGui::GetIO();
+		IO.IniFilename = nullptr;
+		IO.DisplaySize = { 1920.f, 1080.f };
+		IO.DeltaTime = 1.f / 60.f;
+
+		ImGui::NewFrame();
+		ImDrawList* OverlayDrawList = ImGui::GetOverlayDrawList();
+		OverlayDrawList->AddText({ 10.f, 10.f }, IM_COL32(255, 200, 100, 255), "The quick brown fox jumps over the lazy dog 0123456789");
+		OverlayDrawList->AddText({ 10.5f, 40.25f }, IM_COL32(0, 255, 128, 128), "!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~");
+		ImGui::Render();
+
+		// Overlay draw list is rendered after all windows.
+		ImDrawData* DrawData = ImGui::GetDrawData();
+		if (DrawData && DrawData->CmdListsCount > 0)
+		{
+			DrawList.TransferDrawData(*DrawData->CmdLists[DrawData->CmdListsCount - 1]);
+		}
+
+		ImGui::DestroyContext(Context);
+	}
+
+	// Transferred data are only read, so they can be compared directly with the expanded copy.
+	const ImDrawVert* SourceVertices = DrawList.GetRawVertexData();
+	const ImDrawIdx* SourceIndices = DrawList.GetRawIndexData();
+
+	int32 NumTestedQuads = 0;
+	int32 StartIndex = 0;
+	for (int32 CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
+	{
+		const int32 NumElements = static_cast<int32>(DrawList.GetCommand(CommandNb, FTransform2D{}).NumElements);
+		if (NumElements > 0)
+		{
+			TestTrue(FString::Printf(TEXT("Command %d consists of axis-aligned quads"), CommandNb), DrawList.IsAxisAlignedQuads(StartIndex, NumElements));
+
+			TArray<FImGuiGlyphInstance> Instances;
+			DrawList.AppendGlyphInstances(Instances, StartIndex, NumElements);
+			TestEqual(FString::Printf(TEXT("Command %d number of instances"), CommandNb), Instances.Num(), NumElements / 6);
+
+			TArray<ImDrawVert> Vertices;
+			TArray<ImDrawIdx> Indices;
+			Vertices.SetNumZeroed(Instances.Num() * 4);
+			Indices.SetNumZeroed(Instances.Num() * 6);
+			FImGuiGlyphInstance::Expand(Instances, Vertices.GetData(), Indices.GetData());
+
+			// Expanded quads use their own vertices, but in the same order as ImGui, so corners can be matched through indices.
+			for (int32 Quad = 0; Quad < Instances.Num(); Quad++)
+			{
+				const ImDrawIdx* QuadIndices = SourceIndices + StartIndex + Quad * 6;
+				const int32 Corners[] = { static_cast<int32>(QuadIndices[0]), static_cast<int32>(QuadIndices[1]),
+					static_cast<int32>(QuadIndices[2]), static_cast<int32>(QuadIndices[5]) };
+
+				bool bQuadEqual = true;
+				for (int32 Corner = 0; Corner < 4; Corner++)
+				{
+					const ImDrawVert& Expected = SourceVertices[Corners[Corner]];
+					const ImDrawVert& Actual = Vertices[Quad * 4 + Corner];
+					bQuadEqual &= FMemory::Memcmp(&Expected, &Actual, sizeof(ImDrawVert)) == 0;
+				}
+
+				const ImDrawIdx ExpectedIndices[] = { 0, 1, 2, 0, 2, 3 };
+				for (int32 Idx = 0; Idx < 6; Idx++)
+				{
+					bQuadEqual &= Indices[Quad * 6 + Idx] == static_cast<ImDrawIdx>(Quad * 4 + ExpectedIndices[Idx]);
+				}
+
+				if (!bQuadEqual)
+				{
+					const ImDrawVert& Expected = SourceVertices[Corners[0]];
+					const ImDrawVert& Actual = Vertices[Quad * 4];
+					AddError(FString::Printf(TEXT("Command %d, quad %d is different after expanding: first corner at (%f, %f) with UV (%f, %f) ")
+						TEXT("(expected (%f, %f) with UV (%f, %f))."), CommandNb, Quad, Actual.pos.x, Actual.pos.y, Actual.uv.x, Actual.uv.y,
+						Expected.pos.x, Expected.pos.y, Expected.uv.x, Expected.uv.y));
+					break;
+				}
+
+				NumTestedQuads++;
+			}
+		}
+
+		StartIndex += NumElements;
+	}
+
+	TestTrue(TEXT("Text produced glyph quads"), NumTestedQuads > 0);
+
+	return true;
+}
+
+// With 16-bit ImDrawIdx, ImGui cannot build draw lists larger than 64K vertices (see bUse32BitDrawIndices in ImGui.Build.cs).
+#if IMGUI_USE_32BIT_DRAW_INDICES
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiLargeDrawListTest, "ImGui.DrawData.LargeDrawList",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiLargeDrawListTest::RunTest(const FString& Parameters)
+{
+	// Draw list with more vertices than 16-bit indices can address, split into commands with 12K vertices each. Texture
+	// coordinate U of every vertex is its index, so converted vertices can be traced back to their source.
+	constexpr int32 NumQuads = 25000;
+	constexpr int32 QuadsPerCommand = 3000;
+
+	TArray<ImDrawVert> Vertices;
+	TArray<ImDrawIdx> Indices;
+	Vertices.Reserve(NumQuads * 4);
+	Indices.Reserve(NumQuads * 6);
+	for (int32 Quad = 0; Quad < NumQuads; Quad++)
+	{
+		const float X = static_cast<float>(Quad % 200) * 10.f;
+		const float Y = static_cast<float>(Quad / 200) * 10.f;
+		const int32 First = Vertices.Num();
+
+		Vertices.Add({ { X, Y }, { static_cast<float>(First + 0), 0.f }, IM_COL32_WHITE });
+		Vertices.Add({ { X + 8.f, Y }, { static_cast<float>(First + 1), 0.f }, IM_COL32_WHITE });
+		Vertices.Add({ { X + 8.f, Y + 8.f }, { static_cast<float>(First + 2), 0.f }, IM_COL32_WHITE });
+		Vertices.Add({ { X, Y + 8.f }, { static_cast<float>(First + 3), 0.f }, IM_COL32_WHITE });
+
+		const ImDrawIdx QuadIndices[] = { 0, 1, 2, 0, 2, 3 };
+		for (ImDrawIdx Index : QuadIndices)
+		{
+			Indices.Add(static_cast<ImDrawIdx>(First + Index));
+		}
+	}
+
+	FImGuiDrawList DrawList;
+	MakeDrawList(DrawList, Vertices, Indices, QuadsPerCommand * 6);
+	TestTrue(TEXT("Draw list has more than 64K vertices"), DrawList.NumVertices() > (1 << 16));
+
+	// Every command sliced to its own vertex range needs to be addressable by Slate indices and after rebasing, its
+	// indices need to point to the same vertices.
+	TArray<SlateIndex> Converted;
+	int32 StartIndex = 0;
+	for (int32 CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
+	{
+		const FImGuiDrawCommand DrawCommand = DrawList.GetCommand(CommandNb, FTransform2D{});
+		const int32 NumElements = static_cast<int32>(DrawCommand.NumElements);
+		const Utilities::TRange<int32> VertexRange = DrawList.GetVertexRange(StartIndex, NumElements);
+		const int32 NumRangeVertices = VertexRange.GetEnd() - VertexRange.GetBegin();
+
+		TestTrue(FString::Printf(TEXT("Command %d vertex range is addressable by Slate indices"), CommandNb), NumRangeVertices <= MaxSlateIndexedVertices);
+
+		Converted.SetNumUninitialized(NumElements);
+		DrawList.CopyIndexData(Converted.GetData(), StartIndex, NumElements, VertexRange.GetBegin());
+
+		for (int32 Idx = 0; Idx < NumElements; Idx++)
+		{
+			const int32 Rebased = static_cast<int32>(Converted[Idx]);
+			if (Rebased >= NumRangeVertices || Rebased + VertexRange.GetBegin() != static_cast<int32>(Indices[StartIndex + Idx]))
+			{
+				AddError(FString::Printf(TEXT("Command %d, index %d: rebased index %d with offset %d does not address vertex %d."), CommandNb, Idx,
+					Rebased, VertexRange.GetBegin(), static_cast<int32>(Indices[StartIndex + Idx])));
+				break;
+			}
+		}
+
+		StartIndex += NumElements;
+	}
+	TestEqual(TEXT("Number of indices in commands"), StartIndex, Indices.Num());
+
+	// Batches use buffers from the module's pool, so this part needs the module to be running.
+	if (!FImGuiModule::IsAvailable() || !FImGuiModule::Get().GetImGuiModuleManager())
+	{
+		AddWarning(TEXT("ImGui module manager is not available, so draw batches are not tested."));
+		return true;
+	}
+
+	// Quads clipped on the CPU are rebuilt from their corners, so only batches with copied vertices are checked. Draw
+	// lists that cannot be addressed by Slate indices should be sliced, even if slicing is disabled.
+	const FConsoleVariableScope ClipQuads{ TEXT("ImGui.Render.ClipQuadsOnCPU"), 0 };
+	for (int32 SliceVertexData = 0; SliceVertexData <= 1; SliceVertexData++)
+	{
+		const FConsoleVariableScope Slice{ TEXT("ImGui.Render.SliceVertexData"), SliceVertexData };
+
+		FImGuiDrawBatcher Batcher;
+#if WITH_OBSOLETE_CLIPPING_API
+		Batcher.Reset(FTransform2D{}, FLinearColor::White, FSlateRect{ 0.f, 0.f, 3840.f, 2160.f }, FSlateRotatedRect{});
+#else
+		Batcher.Reset(FTransform2D{}, FLinearColor::White, FSlateRect{ 0.f, 0.f, 3840.f, 2160.f });
+#endif // WITH_OBSOLETE_CLIPPING_API
+		Batcher.AddDrawList(DrawList);
+		Batcher.Convert();
+
+		TestEqual(FString::Printf(TEXT("Slice = %d, number of batched commands"), SliceVertexData), Batcher.NumCommands(), DrawList.NumCommands());
+
+		// Batches keep the order of indices, so walking through them should visit all source vertices in the same order.
+		int32 SourceIndex = 0;
+		for (int32 BatchNb = 0; BatchNb < Batcher.NumBatches() && SourceIndex >= 0; BatchNb++)
+		{
+			const FImGuiDrawBatch& Batch = Batcher.GetBatch(BatchNb);
+			TestTrue(FString::Printf(TEXT("Slice = %d, batch %d is addressable by Slate indices"), SliceVertexData, BatchNb),
+				Batch.VertexBuffer->Num() <= MaxSlateIndexedVertices);
+
+			for (const SlateIndex Index : *Batch.IndexBuffer)
+			{
+				const int32 Expected = (SourceIndex < Indices.Num()) ? static_cast<int32>(Indices[SourceIndex]) : INDEX_NONE;
+				if (static_cast<int32>(Index) >= Batch.VertexBuffer->Num()
+					|| (*Batch.VertexBuffer)[Index].TexCoords[0] != static_cast<float>(Expected))
+				{
+					AddError(FString::Printf(TEXT("Slice = %d, batch %d: index %d does not address vertex %d."), SliceVertexData, BatchNb,
+						static_cast<int32>(Index), Expected));
+					SourceIndex = INDEX_NONE;
+					break;
+				}
+				SourceIndex++;
+			}
+		}
+
+		if (SourceIndex >= 0)
+		{
+			TestEqual(FString::Printf(TEXT("Slice = %d, number of batched indices"), SliceVertexData), SourceIndex, Indices.Num());
+		}
+	}
+
+	return true;
+}
+
+#endif // IMGUI_USE_32BIT_DRAW_INDICES
+
+#endif // WITH_DEV_AUTOMATION_TESTS
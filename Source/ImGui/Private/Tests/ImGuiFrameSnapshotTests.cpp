@@ -0,0 +1,105 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiContextManager.h"
+#include "ImGuiContextScope.h"
+#include "ImGuiFrameSnapshot.h"
+#include "ImGuiImplementation.h"
+#include "ImGuiModuleManager.h"
+
+#include <Misc/AutomationTest.h>
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiSteadyStateAllocationsTest, "ImGui.FrameSnapshot.SteadyStateAllocations",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiSteadyStateAllocationsTest::RunTest(const FString& Parameters)
+{
+	// Allocations are counted by the allocator installed during module startup.
+	if (!FImGuiModule::IsAvailable() || !FImGuiModule::Get().GetImGuiModuleManager())
+	{
+		AddWarning(TEXT("ImGui module manager is not available, so allocations are not counted."));
+		return true;
+	}
+
+	// Frames still rendered on workers would allocate while this test counts.
+	FImGuiModule::Get().GetImGuiModuleManager()->GetContextManager().CompleteFrames();
+
+	ImFontAtlas FontAtlas;
+	unsigned char* Pixels;
+	int Width, Height, Bpp;
+	FontAtlas.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+
+	ImGuiContext* Context = ImGui::CreateContext(&FontAtlas);
+	{
+		const FImGuiContextScope ContextScope{ Context };
+
+		ImGuiIO& IO = ImGui::GetIO();
+		IO.IniFilename = nullptr;
+		IO.DisplaySize = { 1920.f, 1080.f };
+		IO.DeltaTime = 1.f / 60.f;
+
+		// Snapshots are updated in turns, like in context proxies, so windows get back buffers from a few frames ago.
+		TRefCountPtr<FImGuiFrameSnapshot> Snapshots[] = { new FImGuiFrameSnapshot(), new FImGuiFrameSnapshot(), new FImGuiFrameSnapshot() };
+		const TArray<FSlateRect> OpaqueRects;
+
+		constexpr int32 NumWindows = 4;
+		const char* WindowNames[NumWindows] = { "Window A", "Window B", "Window C", "Window D" };
+
+		// A different window is focused in every frame, so draw lists are reordered.
+		auto RenderFrame = [&](int32 FrameNb)
+		{
+			ImGui::NewFrame();
+			for (int32 WindowNb = 0; WindowNb < NumWindows; WindowNb++)
+			{
+				if (WindowNb == FrameNb % NumWindows)
+				{
+					ImGui::SetNextWindowFocus();
+				}
+				ImGui::SetNextWindowPos({ 100.f * WindowNb, 50.f * WindowNb });
+				ImGui::SetNextWindowSize({ 300.f, 200.f });
+				ImGui::Begin(WindowNames[WindowNb]);
+				for (int32 Line = 0; Line <= WindowNb * 4; Line++)
+				{
+					ImGui::Text("Line %04d", Line);
+				}
+				ImGui::Button("Button");
+				ImGui::End();
+			}
+			ImGui::Render();
+
+			const int32 SnapshotNb = FrameNb % ARRAY_COUNT(Snapshots);
+			Snapshots[SnapshotNb]->Update(ImGui::GetDrawData(), FrameNb + 1, OpaqueRects);
+		};
+
+		constexpr int32 NumWarmUpFrames = 16;
+		constexpr int32 NumTestedFrames = 64;
+
+		int32 FrameNb = 0;
+		for (; FrameNb < NumWarmUpFrames; FrameNb++)
+		{
+			RenderFrame(FrameNb);
+		}
+
+		const uint32 AllocationsBefore = ImGuiImplementation::GetAllocationsNum();
+		for (; FrameNb < NumWarmUpFrames + NumTestedFrames; FrameNb++)
+		{
+			RenderFrame(FrameNb);
+		}
+		const uint32 Allocations = ImGuiImplementation::GetAllocationsNum() - AllocationsBefore;
+
+		AddInfo(FString::Printf(TEXT("%u ImGui allocations in %d frames after warm-up."), Allocations, NumTestedFrames));
+		if (Allocations > 0)
+		{
+			AddError(TEXT("ImGui allocated memory with the same windows open, so draw list buffers are not reused."));
+		}
+	}
+	ImGui::DestroyContext(Context);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,47 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <HAL/IConsoleManager.h>
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Helpers shared by ImGui automation tests.
+namespace ImGuiTests
+{
+	// Set a console variable for the lifetime of this object.
+	class FConsoleVariableScope
+	{
+	public:
+
+		FConsoleVariableScope(const TCHAR* Name, int32 Value)
+			: Variable(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (Variable)
+			{
+				// Stored as a string, so float variables are restored without truncation.
+				PreviousValue = Variable->GetString();
+				Variable->Set(Value, ECVF_SetByCode);
+			}
+		}
+
+		~FConsoleVariableScope()
+		{
+			if (Variable)
+			{
+				Variable->Set(*PreviousValue, ECVF_SetByCode);
+			}
+		}
+
+		FConsoleVariableScope(const FConsoleVariableScope&) = delete;
+		FConsoleVariableScope& operator=(const FConsoleVariableScope&) = delete;
+
+	private:
+
+		IConsoleVariable* Variable = nullptr;
+		FString PreviousValue;
+	};
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
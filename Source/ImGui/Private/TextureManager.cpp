@@ -33,6 +33,11 @@ TextureIndex FTextureManager::CreateTexture(const FName& Name, int32 Width, int3
 	return TextureResources.Emplace(Name, Texture);
 }
 
+FTexture* FTextureManager::GetTextureResource(TextureIndex Index) const
+{
+	return TextureResources[Index].Texture->Resource;
+}
+
 TextureIndex FTextureManager::CreatePlainTexture(const FName& Name, int32 Width, int32 Height, FColor Color)
 {
 	// Create buffer with raw data.
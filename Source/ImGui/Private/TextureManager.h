@@ -7,6 +7,8 @@
 #include <Textures/SlateShaderResource.h>
 
 
+class FTexture;
+
 // Index type to be used as a texture handle.
 using TextureIndex = int32;
 
@@ -51,6 +53,18 @@ public:
 		return TextureResources[Index].ResourceHandle;
 	}
 
+	// Get the number of textures in this manager.
+	FORCEINLINE int32 NumTextures() const
+	{
+		return TextureResources.Num();
+	}
+
+	// Get the rendering resource of a texture at given index, for direct use on the render thread. Throws exception if
+	// index is out of range.
+	// @param Index - Index of a texture
+	// @returns The rendering resource of a texture at given index (can be null, if texture has no resource)
+	FTexture* GetTextureResource(TextureIndex Index) const;
+
 	// Create a texture from raw data. Throws exception if there is already a texture with that name.
 	// @param Name - The texture name
 	// @param Width - The texture width
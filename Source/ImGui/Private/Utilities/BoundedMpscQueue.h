@@ -0,0 +1,150 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <HAL/PlatformAtomics.h>
+#include <HAL/PlatformMisc.h>
+#include <Math/UnrealMathUtility.h>
+
+
+namespace Utilities
+{
+	//====================================================================================================
+	// Bounded MPSC Queue
+	//====================================================================================================
+
+	// Lock-free queue with a fixed capacity, passing values from multiple producers to a single consumer. Every cell
+	// has a sequence number telling whether it is free in the current lap, so producers only need to agree on the
+	// enqueue position and the consumer never waits for producers. Producers never wait either: when the queue is full,
+	// values are rejected instead of allocating more memory.
+	template<typename T>
+	class TBoundedMpscQueue
+	{
+	public:
+
+		// Create a queue with capacity rounded down to a power of two (at least 2), so it never exceeds the requested
+		// memory.
+		// @param InCapacity - Maximal number of values in the queue
+		explicit TBoundedMpscQueue(int32 InCapacity)
+		{
+			const uint32 Capacity = 1u << FMath::FloorLog2(static_cast<uint32>(FMath::Max(InCapacity, 2)));
+			Mask = Capacity - 1;
+
+			Cells = new FCell[Capacity];
+			for (uint32 Index = 0; Index < Capacity; Index++)
+			{
+				Cells[Index].Sequence = static_cast<int32>(Index);
+			}
+		}
+
+		~TBoundedMpscQueue()
+		{
+			delete[] Cells;
+		}
+
+		// Non-copyable and non-movable, as producers can hold references to it.
+		TBoundedMpscQueue(const TBoundedMpscQueue&) = delete;
+		TBoundedMpscQueue& operator=(const TBoundedMpscQueue&) = delete;
+
+		TBoundedMpscQueue(TBoundedMpscQueue&&) = delete;
+		TBoundedMpscQueue& operator=(TBoundedMpscQueue&&) = delete;
+
+		// Get the maximal number of values in this queue.
+		int32 GetCapacity() const { return static_cast<int32>(Mask + 1); }
+
+		// Get the size in bytes of memory used by queue cells.
+		SIZE_T GetAllocatedSize() const { return (Mask + 1) * sizeof(FCell); }
+
+		//----------------------------------------------------------------------------------------------------
+		// Producers
+		//----------------------------------------------------------------------------------------------------
+
+		// Add a value to the queue, if it is not full. Can be called from any thread.
+		// @param Value - Value to add
+		// @returns True, if value was added or false, if queue was full
+		bool TryPush(const T& Value)
+		{
+			uint32 Position = static_cast<uint32>(EnqueuePosition);
+			for (;;)
+			{
+				FCell& Cell = Cells[Position & Mask];
+				const int32 Difference = static_cast<int32>(static_cast<uint32>(Cell.Sequence) - Position);
+				FPlatformMisc::MemoryBarrier();
+
+				if (Difference == 0)
+				{
+					// Cell is free in this lap, so try to claim it.
+					const uint32 Previous = static_cast<uint32>(FPlatformAtomics::InterlockedCompareExchange(&EnqueuePosition,
+						static_cast<int32>(Position + 1), static_cast<int32>(Position)));
+
+					if (Previous == Position)
+					{
+						Cell.Value = Value;
+
+						// Value must be visible before consumer sees the new sequence.
+						FPlatformMisc::MemoryBarrier();
+						Cell.Sequence = static_cast<int32>(Position + 1);
+						return true;
+					}
+
+					Position = Previous;
+				}
+				else if (Difference < 0)
+				{
+					// Cell still holds a value from the previous lap, so the queue is full.
+					return false;
+				}
+				else
+				{
+					// Other producer claimed this cell in the meantime.
+					Position = static_cast<uint32>(EnqueuePosition);
+				}
+			}
+		}
+
+		//----------------------------------------------------------------------------------------------------
+		// Consumer
+		//----------------------------------------------------------------------------------------------------
+
+		// Take the oldest value from the queue. Should be called by one thread at a time.
+		// @param OutValue - Destination for the value
+		// @returns True, if value was taken or false, if queue was empty
+		bool TryPop(T& OutValue)
+		{
+			FCell& Cell = Cells[DequeuePosition & Mask];
+			const int32 Difference = static_cast<int32>(static_cast<uint32>(Cell.Sequence) - (DequeuePosition + 1));
+			FPlatformMisc::MemoryBarrier();
+
+			if (Difference < 0)
+			{
+				// Nothing was published to this cell yet.
+				return false;
+			}
+
+			OutValue = MoveTemp(Cell.Value);
+
+			// Value must be read before producers see this cell as free in the next lap.
+			FPlatformMisc::MemoryBarrier();
+			Cell.Sequence = static_cast<int32>(DequeuePosition + Mask + 1);
+			DequeuePosition++;
+			return true;
+		}
+
+	private:
+
+		struct FCell
+		{
+			T Value;
+			volatile int32 Sequence;
+		};
+
+		FCell* Cells = nullptr;
+		uint32 Mask = 0;
+
+		// Positions are written by different sides, so they are padded to stay on different cache lines.
+		uint8 PaddingBeforeEnqueue[PLATFORM_CACHE_LINE_SIZE];
+		volatile int32 EnqueuePosition = 0;
+		uint8 PaddingBeforeDequeue[PLATFORM_CACHE_LINE_SIZE];
+		uint32 DequeuePosition = 0;
+	};
+}
@@ -0,0 +1,81 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <HAL/PlatformAtomics.h>
+
+
+namespace Utilities
+{
+	//====================================================================================================
+	// Triple Buffer
+	//====================================================================================================
+
+	// Lock-free triple buffer passing values from a single producer to a single consumer. Producer writes to its own
+	// back buffer and publishes it by swapping it with the middle buffer. Consumer takes the latest published value by
+	// swapping its front buffer with the middle one. Neither side ever waits for the other and values that consumer
+	// didn't manage to take are overwritten by newer ones.
+	template<typename T>
+	class TTripleBuffer
+	{
+	public:
+
+		TTripleBuffer() = default;
+
+		// Non-copyable, but movable as long as neither side is in use.
+		TTripleBuffer(const TTripleBuffer&) = delete;
+		TTripleBuffer& operator=(const TTripleBuffer&) = delete;
+
+		TTripleBuffer(TTripleBuffer&&) = default;
+		TTripleBuffer& operator=(TTripleBuffer&&) = default;
+
+		//----------------------------------------------------------------------------------------------------
+		// Producer
+		//----------------------------------------------------------------------------------------------------
+
+		// Get the buffer owned by producer. Its content is not visible to consumer until published.
+		T& GetBack() { return Buffers[BackIndex]; }
+
+		// Make the back buffer available to consumer and take a new back buffer (the one that consumer didn't take yet
+		// or the one that consumer released).
+		void Publish()
+		{
+			// Full barrier makes sure that all writes to the back buffer are visible before it is published.
+			const int32 OldMiddle = FPlatformAtomics::InterlockedExchange(&MiddleState, BackIndex | DirtyFlag);
+			BackIndex = OldMiddle & IndexMask;
+		}
+
+		//----------------------------------------------------------------------------------------------------
+		// Consumer
+		//----------------------------------------------------------------------------------------------------
+
+		// Take the latest published buffer, if there is any newer than the current front buffer.
+		// @returns True, if front buffer has changed
+		bool Update()
+		{
+			// Cheap check before exchange. If producer publishes in the meantime, it will be taken in the next update.
+			if ((MiddleState & DirtyFlag) == 0)
+			{
+				return false;
+			}
+
+			const int32 OldMiddle = FPlatformAtomics::InterlockedExchange(&MiddleState, FrontIndex);
+			FrontIndex = OldMiddle & IndexMask;
+			return true;
+		}
+
+		// Get the buffer owned by consumer. It stays unchanged until the next update.
+		const T& GetFront() const { return Buffers[FrontIndex]; }
+
+	private:
+
+		static constexpr int32 IndexMask = 0x3;
+		static constexpr int32 DirtyFlag = 0x4;
+
+		T Buffers[3];
+
+		int32 BackIndex = 0;
+		volatile int32 MiddleState = 1;
+		int32 FrontIndex = 2;
+	};
+}
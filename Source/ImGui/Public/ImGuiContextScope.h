@@ -0,0 +1,51 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Core.h>
+
+#include <imgui.h>
+
+
+/**
+ * Scoped guard that makes an ImGui context current and restores the previous one at the end of the scope.
+ *
+ * If ImGui is built with thread-local contexts (bThreadLocalContext in ImGui.Build.cs), the guard only affects the
+ * calling thread. This allows async systems to record UI into their own contexts (e.g. created with
+ * ImGui::CreateContext) without racing the game thread and contexts managed by this module. Without thread-local
+ * contexts, the current context is shared by all threads and the guard can be only used on the game thread.
+ */
+class FImGuiContextScope
+{
+public:
+
+	/** Whether the current ImGui context is thread-local, so different threads can use different contexts. */
+	static constexpr bool IsThreadLocal() { return IMGUI_THREAD_LOCAL_CONTEXT != 0; }
+
+	/**
+	 * Make the given context current for the lifetime of this guard.
+	 *
+	 * @param Context - Context to make current (can be null)
+	 */
+	explicit FImGuiContextScope(ImGuiContext* Context)
+		: PreviousContext(ImGui::GetCurrentContext())
+	{
+		checkf(IsThreadLocal() || IsInGameThread(), TEXT("ImGui is built without thread-local contexts, so contexts can be only changed on the game thread."));
+		ImGui::SetCurrentContext(Context);
+	}
+
+	~FImGuiContextScope()
+	{
+		ImGui::SetCurrentContext(PreviousContext);
+	}
+
+	FImGuiContextScope(const FImGuiContextScope&) = delete;
+	FImGuiContextScope& operator=(const FImGuiContextScope&) = delete;
+
+	FImGuiContextScope(FImGuiContextScope&&) = delete;
+	FImGuiContextScope& operator=(FImGuiContextScope&&) = delete;
+
+private:
+
+	ImGuiContext* PreviousContext;
+};
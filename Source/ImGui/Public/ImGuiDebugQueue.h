@@ -0,0 +1,114 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Core.h>
+
+#include <imgui.h>
+
+
+/**
+ * Queue of debug commands that can be pushed from any thread and that are drawn by the owning ImGui context during its
+ * next update. This allows worker threads (AI, physics, streaming etc.) to show debug information without marshalling
+ * data back to the game thread.
+ *
+ * Pushing is lock-free and never blocks. Each context has a fixed memory budget for commands (see
+ * ImGui.DebugQueue.Budget) and commands that do not fit are dropped and counted as overflows. Strings are copied into
+ * commands and truncated if they are too long.
+ *
+ * Commands are visualised in the following way:
+ * - Text lines are shown in the named window in the frame in which they are drawn, so they need to be pushed every frame.
+ * - Values are shown in the named window and updated with every new value pushed under the same key.
+ * - Plot samples are added to a history of the named plot, shown in the named window.
+ * - Primitives are drawn on top of all windows in the frame in which they are drawn. Positions are in ImGui canvas space.
+ *
+ * Get the queue with FImGuiModule::GetDebugQueue. Returned pointer can be used from any thread and it keeps the queue
+ * valid even after its context is destroyed.
+ */
+class IMGUI_API FImGuiDebugQueue
+{
+public:
+
+	~FImGuiDebugQueue();
+
+	FImGuiDebugQueue(const FImGuiDebugQueue&) = delete;
+	FImGuiDebugQueue& operator=(const FImGuiDebugQueue&) = delete;
+
+	FImGuiDebugQueue(FImGuiDebugQueue&&) = delete;
+	FImGuiDebugQueue& operator=(FImGuiDebugQueue&&) = delete;
+
+	/**
+	 * Add a text line to the named window.
+	 *
+	 * @param Window - Name of the window (null for default)
+	 * @param Text - Text to show
+	 * @param Color - Text color
+	 * @returns True, if command was added or false, if queue was full
+	 */
+	bool AddText(const char* Window, const char* Text, ImU32 Color = IM_COL32_WHITE);
+
+	/**
+	 * Set value shown in the named window under the given key.
+	 *
+	 * @param Window - Name of the window (null for default)
+	 * @param Key - Key identifying the value in the window
+	 * @param Value - Value to show
+	 * @returns True, if command was added or false, if queue was full
+	 */
+	bool AddValue(const char* Window, const char* Key, const char* Value);
+
+	/**
+	 * Add a sample to the named plot in the named window.
+	 *
+	 * @param Window - Name of the window (null for default)
+	 * @param Plot - Name of the plot
+	 * @param Value - Sample value
+	 * @returns True, if command was added or false, if queue was full
+	 */
+	bool AddPlotSample(const char* Window, const char* Plot, float Value);
+
+	/**
+	 * Draw a line on top of all windows.
+	 *
+	 * @returns True, if command was added or false, if queue was full
+	 */
+	bool AddLine(const ImVec2& Start, const ImVec2& End, ImU32 Color, float Thickness = 1.f);
+
+	/**
+	 * Draw a rectangle on top of all windows.
+	 *
+	 * @returns True, if command was added or false, if queue was full
+	 */
+	bool AddRect(const ImVec2& Min, const ImVec2& Max, ImU32 Color, float Thickness = 1.f);
+
+	/**
+	 * Draw a circle on top of all windows.
+	 *
+	 * @returns True, if command was added or false, if queue was full
+	 */
+	bool AddCircle(const ImVec2& Center, float Radius, ImU32 Color, float Thickness = 1.f);
+
+	/** Get the maximal number of commands that can wait in this queue. */
+	int32 GetCapacity() const;
+
+	/** Get the number of commands that were dropped because the queue was full. */
+	int32 GetNumOverflows() const { return NumOverflows; }
+
+private:
+
+	// Queues are created and drained by context proxies.
+	friend class FImGuiContextProxy;
+
+	struct FImpl;
+	struct FCommand;
+
+	FImGuiDebugQueue();
+
+	bool Push(const FCommand& Command);
+
+	// Drain the queue to the current ImGui context. Should be called by one thread at a time, during the context frame.
+	void Draw();
+
+	TUniquePtr<FImpl> Impl;
+	volatile int32 NumOverflows = 0;
+};
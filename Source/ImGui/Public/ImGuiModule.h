@@ -6,6 +6,7 @@
 
 #include <ModuleManager.h>
 
+class FImGuiDebugQueue;
 class FImGuiModuleManager;
 
 class FImGuiModule : public IModuleInterface
@@ -43,6 +44,41 @@ public:
 	 */
 	virtual FImGuiDelegateHandle AddMultiContextImGuiDelegate(const FImGuiDelegate& Delegate);
 
+	/**
+	 * Add shared delegate that is safe to call from any thread. It is called for each ImGui context after delegates
+	 * added with AddMultiContextImGuiDelegate. When contexts are ticked in parallel (ImGui.ParallelTick), it can be
+	 * called on worker threads, so it should only use ImGui and data that can be safely accessed from any thread while the
+	 * game thread waits for the tick to finish. Calls for different contexts are serialised, so delegate is never called
+	 * concurrently with itself.
+	 *
+	 * @param Delegate - Delegate that we want to add (@see FImGuiDelegate::Create...)
+	 * @returns Returns handle that can be used to remove delegate (@see RemoveImGuiDelegate)
+	 */
+	virtual FImGuiDelegateHandle AddThreadSafeMultiContextImGuiDelegate(const FImGuiDelegate& Delegate);
+
+	/**
+	 * Get queue of debug commands for an ImGui context, creating the context if it does not exist yet. Should be called
+	 * from the game thread, but the returned queue can be used from any thread (@see FImGuiDebugQueue, which is declared
+	 * in ImGuiDebugQueue.h).
+	 *
+	 * @param World - World that owns the context (in editor, null or editor worlds use the editor context)
+	 * @param ContextName - Name of the context, the same as used by ImGui widgets
+	 * @returns Returns queue that stays valid as long as it is referenced, even after its context is destroyed
+	 */
+	virtual TSharedRef<FImGuiDebugQueue, ESPMode::ThreadSafe> GetDebugQueue(UWorld* World, const FName& ContextName = NAME_None);
+
+	/**
+	 * Set the maximal update rate of an ImGui context, creating the context if it does not exist yet. Engine frames
+	 * between updates reuse the last draw data. This overrides the default from ImGui.UpdateRate and ImGui settings.
+	 * Throttling applies to drawing from ImGui delegates. Direct ImGui calls made in engine frames without update are
+	 * discarded.
+	 *
+	 * @param World - World that owns the context (in editor, null or editor worlds use the editor context)
+	 * @param ContextName - Name of the context, the same as used by ImGui widgets
+	 * @param UpdateRate - Maximal number of frames per second (0 for no limit or negative to use the default)
+	 */
+	virtual void SetContextUpdateRate(UWorld* World, const FName& ContextName, float UpdateRate);
+
 	/**
 	 * Remove delegate added with any version of Add...ImGuiDelegate
 	 *
@@ -5,6 +5,7 @@
 
 class FImGuiContextProxy;
 class FImGuiContextManager;
+class FImGuiDrawBufferPool;
 class FTextureManager;
 
 
@@ -22,7 +23,12 @@ public:
 	// Get texture resources manager.
 	FTextureManager& GetTextureManager() { return *TextureManager; }
 
-	// Event called right after ImGui is updated, to give other subsystems chance to react.
+	// Get pool of frame-scoped buffers for converted draw data.
+	FImGuiDrawBufferPool& GetDrawBufferPool() { return *DrawBufferPool; }
+
+	// Event called right after ImGui is updated, to give other subsystems chance to react. If frames are rendered on
+	// workers (see ImGui.PipelinedRender), there is no current context at that point and listeners that want to draw
+	// need to set one (setting context as current waits for its render task).
 	FSimpleMulticastDelegate& OnPostImGuiUpdate() { return PostImGuiUpdateEvent; }
 
 	// Event called right before ImGui is updated, to give other subsystems chance to react.
@@ -70,6 +76,9 @@ private:
 	// Manager for textures resources.
 	FTextureManager * TextureManager;
 
+	// Pool of buffers for converted draw data.
+	FImGuiDrawBufferPool * DrawBufferPool;
+
 	FDelegateHandle TickInitializerHandle;
 	FDelegateHandle TickDelegateHandle;
 
@@ -0,0 +1,85 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+using System.IO;
+using UnrealBuildTool;
+
+// Global shaders used by the direct ImGui renderer. Shader types need to be registered before the global shader map is
+// compiled, so unlike the main module, this one is loaded in the PostConfigInit phase. It is also loaded in commandlets,
+// so its shaders are compiled into cooked global shader maps.
+public class ImGuiShaders : ModuleRules
+{
+	// Whether the direct renderer (see ImGui.Render.DirectRenderer) and its shaders should be compiled. It uses shader
+	// APIs added in UE 4.21, so in older engines it is always disabled and this module is empty.
+	public static bool bDirectRenderer = true;
+
+	// Check whether the direct renderer is compiled in the current engine. This is exported as IMGUI_DIRECT_RENDERER to
+	// all modules that use this one.
+	public static bool IsDirectRendererEnabled()
+	{
+#if UE_4_21_OR_LATER
+		return bDirectRenderer;
+#else
+		return false;
+#endif
+	}
+
+#if WITH_FORWARDED_MODULE_RULES_CTOR
+	public ImGuiShaders(ReadOnlyTargetRules Target) : base(Target)
+#else
+	public ImGuiShaders(TargetInfo Target)
+#endif
+	{
+		PublicIncludePaths.AddRange(
+			new string[] {
+				Path.Combine(ModuleDirectory, "Public")
+			}
+			);
+
+
+		PrivateIncludePaths.AddRange(
+			new string[] {
+				Path.Combine(ModuleDirectory, "Private")
+			}
+			);
+
+
+		string DirectRendererDefinition = "IMGUI_DIRECT_RENDERER=" + (IsDirectRendererEnabled() ? "1" : "0");
+#if UE_4_19_OR_LATER
+		PublicDefinitions.Add(DirectRendererDefinition);
+#else
+		Definitions.Add(DirectRendererDefinition);
+#endif
+
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core"
+			}
+			);
+
+		if (IsDirectRendererEnabled())
+		{
+			PublicDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"RenderCore",
+					"RHI"
+				}
+				);
+
+#if !UE_4_22_OR_LATER
+			// Shader core was merged into render core in UE 4.22.
+			PublicDependencyModuleNames.Add("ShaderCore");
+#endif
+		}
+
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Projects"
+			}
+			);
+	}
+}
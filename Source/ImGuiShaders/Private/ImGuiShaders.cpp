@@ -0,0 +1,95 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiShaders.h"
+
+#include <ModuleManager.h>
+
+#if IMGUI_DIRECT_RENDERER
+#include <IPluginManager.h>
+#include <ShaderCore.h>
+#endif // IMGUI_DIRECT_RENDERER
+
+
+#if IMGUI_DIRECT_RENDERER
+
+
+FImGuiVertexDeclaration::FImGuiVertexDeclaration(const FVertexDeclarationElementList& InElements)
+	: Elements(InElements)
+{
+}
+
+void FImGuiVertexDeclaration::InitRHI()
+{
+	VertexDeclarationRHI = RHICreateVertexDeclaration(Elements);
+}
+
+void FImGuiVertexDeclaration::ReleaseRHI()
+{
+	VertexDeclarationRHI.SafeRelease();
+}
+
+FImGuiVS::FImGuiVS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+	: FGlobalShader(Initializer)
+{
+	TransformParameter.Bind(Initializer.ParameterMap, TEXT("Transform"));
+}
+
+void FImGuiVS::SetParameters(FRHICommandList& RHICmdList, const FVector2D& Scale, const FVector2D& Offset)
+{
+	SetShaderValue(RHICmdList, GetVertexShader(), TransformParameter, FVector4{ Scale.X, Scale.Y, Offset.X, Offset.Y });
+}
+
+bool FImGuiVS::Serialize(FArchive& Ar)
+{
+	const bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+	Ar << TransformParameter;
+	return bShaderHasOutdatedParameters;
+}
+
+FImGuiPS::FImGuiPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+	: FGlobalShader(Initializer)
+{
+	TintParameter.Bind(Initializer.ParameterMap, TEXT("Tint"));
+	TextureParameter.Bind(Initializer.ParameterMap, TEXT("Texture"));
+	TextureSamplerParameter.Bind(Initializer.ParameterMap, TEXT("TextureSampler"));
+}
+
+void FImGuiPS::SetTint(FRHICommandList& RHICmdList, const FLinearColor& Tint)
+{
+	SetShaderValue(RHICmdList, GetPixelShader(), TintParameter, Tint);
+}
+
+void FImGuiPS::SetTexture(FRHICommandList& RHICmdList, FTextureRHIParamRef Texture, FSamplerStateRHIParamRef Sampler)
+{
+	SetTextureParameter(RHICmdList, GetPixelShader(), TextureParameter, TextureSamplerParameter, Sampler, Texture);
+}
+
+bool FImGuiPS::Serialize(FArchive& Ar)
+{
+	const bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+	Ar << TintParameter << TextureParameter << TextureSamplerParameter;
+	return bShaderHasOutdatedParameters;
+}
+
+IMPLEMENT_SHADER_TYPE(, FImGuiVS, TEXT("/Plugin/ImGui/Private/ImGui.usf"), TEXT("MainVS"), SF_Vertex);
+IMPLEMENT_SHADER_TYPE(, FImGuiGlyphVS, TEXT("/Plugin/ImGui/Private/ImGui.usf"), TEXT("MainGlyphVS"), SF_Vertex);
+IMPLEMENT_SHADER_TYPE(, FImGuiPS, TEXT("/Plugin/ImGui/Private/ImGui.usf"), TEXT("MainPS"), SF_Pixel);
+
+#endif // IMGUI_DIRECT_RENDERER
+
+
+class FImGuiShadersModule : public IModuleInterface
+{
+public:
+
+	virtual void StartupModule() override
+	{
+#if IMGUI_DIRECT_RENDERER
+		// Map virtual shader path to the plugin's shader directory.
+		const FString ShaderDirectory = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("ImGui"))->GetBaseDir(), TEXT("Shaders"));
+		AddShaderSourceDirectoryMapping(TEXT("/Plugin/ImGui"), ShaderDirectory);
+#endif // IMGUI_DIRECT_RENDERER
+	}
+};
+
+IMPLEMENT_MODULE(FImGuiShadersModule, ImGuiShaders)
@@ -0,0 +1,99 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Core.h>
+
+// Shaders are only compiled in engines that support the direct renderer (see ImGuiShaders.Build.cs).
+#if IMGUI_DIRECT_RENDERER
+
+#include <GlobalShader.h>
+#include <RenderResource.h>
+#include <ShaderParameters.h>
+#include <ShaderParameterUtils.h>
+
+
+// Vertex declaration with elements defined by the user (like ImDrawVert layout, which is not known to this module).
+class IMGUISHADERS_API FImGuiVertexDeclaration : public FRenderResource
+{
+public:
+
+	// Create a declaration with the given elements.
+	explicit FImGuiVertexDeclaration(const FVertexDeclarationElementList& InElements);
+
+	virtual void InitRHI() override;
+	virtual void ReleaseRHI() override;
+
+	FVertexDeclarationRHIRef VertexDeclarationRHI;
+
+private:
+
+	FVertexDeclarationElementList Elements;
+};
+
+// Vertex shader transforming ImGui vertices from canvas to clip space.
+class IMGUISHADERS_API FImGuiVS : public FGlobalShader
+{
+	DECLARE_SHADER_TYPE(FImGuiVS, Global);
+
+public:
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters) { return true; }
+
+	FImGuiVS() = default;
+	FImGuiVS(const ShaderMetaType::CompiledShaderInitializerType& Initializer);
+
+	// Set the transform from ImGui canvas to clip space.
+	// @param RHICmdList - Command list
+	// @param Scale - Scale from canvas to clip space
+	// @param Offset - Offset in clip space
+	void SetParameters(FRHICommandList& RHICmdList, const FVector2D& Scale, const FVector2D& Offset);
+
+	virtual bool Serialize(FArchive& Ar) override;
+
+private:
+
+	FShaderParameter TransformParameter;
+};
+
+// Vertex shader expanding glyph instances to quads. Uses the same parameters as FImGuiVS.
+class IMGUISHADERS_API FImGuiGlyphVS : public FImGuiVS
+{
+	DECLARE_SHADER_TYPE(FImGuiGlyphVS, Global);
+
+public:
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters) { return true; }
+
+	FImGuiGlyphVS() = default;
+	FImGuiGlyphVS(const ShaderMetaType::CompiledShaderInitializerType& Initializer) : FImGuiVS(Initializer) {}
+};
+
+// Pixel shader sampling ImGui texture and modulating it by vertex color and tint.
+class IMGUISHADERS_API FImGuiPS : public FGlobalShader
+{
+	DECLARE_SHADER_TYPE(FImGuiPS, Global);
+
+public:
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters) { return true; }
+
+	FImGuiPS() = default;
+	FImGuiPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer);
+
+	// Set the tint applied to all pixels.
+	void SetTint(FRHICommandList& RHICmdList, const FLinearColor& Tint);
+
+	// Set the texture sampled by pixels.
+	void SetTexture(FRHICommandList& RHICmdList, FTextureRHIParamRef Texture, FSamplerStateRHIParamRef Sampler);
+
+	virtual bool Serialize(FArchive& Ar) override;
+
+private:
+
+	FShaderParameter TintParameter;
+	FShaderResourceParameter TextureParameter;
+	FShaderResourceParameter TextureSamplerParameter;
+};
+
+#endif // IMGUI_DIRECT_RENDERER
@@ -63,6 +63,22 @@
 //---- Use 32-bit vertex indices (default is 16-bit) to allow meshes with more than 64K vertices. Render function needs to support it.
 //#define ImDrawIdx unsigned int
 
+//---- [Unreal ImGui] 32-bit vertex indices are enabled for all modules with bUse32BitDrawIndices in ImGui.Build.cs.
+#if defined(IMGUI_USE_32BIT_DRAW_INDICES) && IMGUI_USE_32BIT_DRAW_INDICES
+#define ImDrawIdx unsigned int
+#endif
+
+//---- [Unreal ImGui] Current context is thread-local for all modules with bThreadLocalContext in ImGui.Build.cs, so
+// different contexts can be used on different threads at the same time. Storage is defined in ImGuiImplementation.cpp.
+#if defined(IMGUI_THREAD_LOCAL_CONTEXT) && IMGUI_THREAD_LOCAL_CONTEXT
+struct ImGuiContext;
+namespace ImGuiImplementation
+{
+    IMGUI_API ImGuiContext*& GetThreadLocalContext();
+}
+#define GImGui ImGuiImplementation::GetThreadLocalContext()
+#endif
+
 //---- Tip: You can add extra functions within the ImGui:: namespace, here or in your own headers files.
 /*
 namespace ImGui